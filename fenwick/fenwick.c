@@ -0,0 +1,120 @@
+#include "fenwick.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static void fenwick_check_index(const FenwickTree *fenwick, int index, const char *caller)
+{
+    if (index < 0 || index >= fenwick->size)
+    {
+        fprintf(stderr, "Index out of bounds in %s (index=%d, size=%d)\n", caller, index, fenwick->size);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// CORE MANAGEMENT (Creation, Destruction, Properties)
+// -----------------------------------------------------------------------------
+
+FenwickTree fenwick_create(int size)
+{
+    if (size < 0)
+    {
+        fprintf(stderr, "%d is negative\n", size);
+        exit(EXIT_FAILURE);
+    }
+
+    FenwickTree fenwick;
+    fenwick.size = size;
+    fenwick.tree = (long long *)calloc(size + 1, sizeof(long long));
+    if (!fenwick.tree)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    return fenwick;
+}
+
+FenwickTree fenwick_from_vector(const Vector *vec)
+{
+    FenwickTree fenwick = fenwick_create(vec->size);
+    long long *tree = fenwick.tree;
+
+    // O(n) build: each node pushes its finished total into its parent once
+    for (int i = 1; i <= vec->size; i++)
+    {
+        tree[i] += vec->data[i - 1];
+
+        int parent = i + (i & -i);
+        if (parent <= vec->size)
+            tree[parent] += tree[i];
+    }
+
+    return fenwick;
+}
+
+void fenwick_destroy(FenwickTree *fenwick)
+{
+    free(fenwick->tree);
+    fenwick->tree = NULL;
+    fenwick->size = 0;
+}
+
+int fenwick_size(const FenwickTree *fenwick)
+{
+    return fenwick->size;
+}
+
+// -----------------------------------------------------------------------------
+// UPDATES & QUERIES (Point Update, Prefix Sum, Range Sum)
+// -----------------------------------------------------------------------------
+
+void fenwick_add(FenwickTree *fenwick, int index, long long delta)
+{
+    fenwick_check_index(fenwick, index, "fenwick_add");
+
+    for (int i = index + 1; i <= fenwick->size; i += i & -i)
+    {
+        fenwick->tree[i] += delta;
+    }
+}
+
+void fenwick_set(FenwickTree *fenwick, int index, long long value)
+{
+    fenwick_add(fenwick, index, value - fenwick_get(fenwick, index));
+}
+
+long long fenwick_get(const FenwickTree *fenwick, int index)
+{
+    fenwick_check_index(fenwick, index, "fenwick_get");
+
+    return fenwick_range_sum(fenwick, index, index + 1);
+}
+
+long long fenwick_prefix_sum(const FenwickTree *fenwick, int count)
+{
+    if (count < 0 || count > fenwick->size)
+    {
+        fprintf(stderr, "Index out of bounds in fenwick_prefix_sum (count=%d, size=%d)\n", count, fenwick->size);
+        exit(EXIT_FAILURE);
+    }
+
+    long long sum = 0;
+
+    for (int i = count; i > 0; i -= i & -i)
+    {
+        sum += fenwick->tree[i];
+    }
+
+    return sum;
+}
+
+long long fenwick_range_sum(const FenwickTree *fenwick, int from_index, int to_index)
+{
+    if (from_index > to_index)
+    {
+        fprintf(stderr, "Indices are out of order\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return fenwick_prefix_sum(fenwick, to_index) - fenwick_prefix_sum(fenwick, from_index);
+}
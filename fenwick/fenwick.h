@@ -0,0 +1,35 @@
+#ifndef FENWICK_H
+#define FENWICK_H
+
+#include "../vector/vector.h"
+
+// Binary indexed tree over the elements of a Vector: O(log n) point update
+// and range sum, with 64-bit totals so large sums do not overflow.
+typedef struct
+{
+    long long *tree; // 1-based partial sums, tree[0] unused
+    int size;        // Number of indexed elements
+} FenwickTree;
+
+// -----------------------------------------------------------------------------
+// CORE MANAGEMENT (Creation, Destruction, Properties)
+// -----------------------------------------------------------------------------
+
+FenwickTree fenwick_create(int size);
+FenwickTree fenwick_from_vector(const Vector *vec);
+void fenwick_destroy(FenwickTree *fenwick);
+
+int fenwick_size(const FenwickTree *fenwick);
+
+// -----------------------------------------------------------------------------
+// UPDATES & QUERIES (Point Update, Prefix Sum, Range Sum)
+// -----------------------------------------------------------------------------
+
+void fenwick_add(FenwickTree *fenwick, int index, long long delta);
+void fenwick_set(FenwickTree *fenwick, int index, long long value);
+long long fenwick_get(const FenwickTree *fenwick, int index);
+
+long long fenwick_prefix_sum(const FenwickTree *fenwick, int count);
+long long fenwick_range_sum(const FenwickTree *fenwick, int from_index, int to_index);
+
+#endif // FENWICK_H
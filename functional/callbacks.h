@@ -0,0 +1,16 @@
+#ifndef CALLBACKS_H
+#define CALLBACKS_H
+
+#include <stdbool.h>
+
+// Declares the three callback types for element type T, named by prefixing
+// CB (which may be empty):
+//   CB##Predicate: Takes a T, returns true/false
+//   CB##Function:  Takes a T, returns a T (for map, etc.)
+//   CB##Consumer:  Takes a T, returns nothing (for foreach)
+#define FUNCTIONAL_CALLBACKS(T, CB)   \
+    typedef bool (*CB##Predicate)(T); \
+    typedef T (*CB##Function)(T);     \
+    typedef void (*CB##Consumer)(T);
+
+#endif // CALLBACKS_H
@@ -1,14 +1,18 @@
 #ifndef FUNCTIONAL_H
 #define FUNCTIONAL_H
 
-// Predicate: Takes an int, returns true/false
-typedef bool (*Predicate)(int);
+#include "callbacks.h"
 
-// Function: Takes an int, returns an int (for map, etc.)
-typedef int (*Function)(int);
+#ifdef __cplusplus
+extern "C"
+{
+#endif
 
-// Consumer: Takes an int, returns nothing (for foreach)
-typedef void (*Consumer)(int);
+// The int callbacks, declared like those of every template vector:
+//   Predicate: Takes an int, returns true/false
+//   Function:  Takes an int, returns an int (for map, etc.)
+//   Consumer:  Takes an int, returns nothing (for foreach)
+FUNCTIONAL_CALLBACKS(int, )
 
 // Common predicates
 bool is_even(int x);
@@ -24,4 +28,8 @@ int square(int x);
 // Common consumers
 void print_int(int x);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif // FUNCTIONAL_H
\ No newline at end of file
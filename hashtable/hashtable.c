@@ -0,0 +1,550 @@
+#include "hashtable.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define HASH_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define HASH_PREFETCH(addr) ((void)(addr))
+#endif
+
+#define CTRL_EMPTY ((int8_t)-128)
+#define CTRL_DELETED ((int8_t)-2)
+
+// -----------------------------------------------------------------------------
+// HASHING & GROUP PROBING (Internal)
+// -----------------------------------------------------------------------------
+
+static uint64_t hash_int(int key)
+{
+    // Final mixer of MurmurHash3: every input bit affects every output bit
+    uint64_t h = (uint64_t)(uint32_t)key;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// Upper bits pick the starting slot, the low 7 bits go into the control byte
+static int hash_h1(uint64_t hash, int capacity)
+{
+    return (int)((hash >> 7) & (uint64_t)(capacity - 1));
+}
+
+static int8_t hash_h2(uint64_t hash)
+{
+    return (int8_t)(hash & 0x7F);
+}
+
+// Bit i of the result is set when ctrl[i] == value
+static unsigned group_match(const int8_t *ctrl, int8_t value)
+{
+#if defined(__SSE2__)
+    __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(value)));
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < HASH_GROUP_WIDTH; i++)
+    {
+        if (ctrl[i] == value)
+            mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+// Bit i of the result is set when slot i is empty or deleted (sign bit set)
+static unsigned group_match_free(const int8_t *ctrl)
+{
+#if defined(__SSE2__)
+    return (unsigned)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < HASH_GROUP_WIDTH; i++)
+    {
+        if (ctrl[i] < 0)
+            mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+static int lowest_bit(unsigned mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int bit = 0;
+    while (!(mask & 1u))
+    {
+        mask >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// TABLE CORE (Shared by IntSet and IntMap)
+// -----------------------------------------------------------------------------
+
+static int table_max_load(int capacity)
+{
+    return capacity - capacity / 8;
+}
+
+static int table_capacity_for(int min_size)
+{
+    int capacity = HASH_GROUP_WIDTH;
+    while (table_max_load(capacity) < min_size)
+    {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+static void table_set_ctrl(IntHashTable *table, int index, int8_t value)
+{
+    table->ctrl[index] = value;
+
+    // The first bytes are mirrored past the end so that a group loaded near
+    // the end of the table wraps around without a bounds check.
+    if (index < HASH_GROUP_WIDTH - 1)
+        table->ctrl[table->capacity + index] = value;
+}
+
+static void table_init(IntHashTable *table, int min_size, bool with_values)
+{
+    int capacity = table_capacity_for(min_size);
+
+    table->ctrl = (int8_t *)malloc(capacity + HASH_GROUP_WIDTH - 1);
+    table->keys = (int *)malloc(capacity * sizeof(int));
+    table->values = with_values ? (int *)malloc(capacity * sizeof(int)) : NULL;
+
+    if (!table->ctrl || !table->keys || (with_values && !table->values))
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    memset(table->ctrl, (uint8_t)CTRL_EMPTY, capacity + HASH_GROUP_WIDTH - 1);
+    table->size = 0;
+    table->capacity = capacity;
+    table->growth_left = table_max_load(capacity);
+}
+
+static void table_destroy(IntHashTable *table)
+{
+    free(table->ctrl);
+    free(table->keys);
+    free(table->values);
+    table->ctrl = NULL;
+    table->keys = NULL;
+    table->values = NULL;
+    table->size = table->capacity = table->growth_left = 0;
+}
+
+static void table_clear(IntHashTable *table)
+{
+    memset(table->ctrl, (uint8_t)CTRL_EMPTY, table->capacity + HASH_GROUP_WIDTH - 1);
+    table->size = 0;
+    table->growth_left = table_max_load(table->capacity);
+}
+
+// Returns the slot holding key, or -1 if it is absent
+static int table_find(const IntHashTable *table, int key)
+{
+    uint64_t hash = hash_int(key);
+    int8_t h2 = hash_h2(hash);
+    int mask = table->capacity - 1;
+    int pos = hash_h1(hash, table->capacity);
+
+    for (int step = HASH_GROUP_WIDTH;; step += HASH_GROUP_WIDTH)
+    {
+        const int8_t *group = table->ctrl + pos;
+        unsigned matches = group_match(group, h2);
+
+        while (matches)
+        {
+            int index = (pos + lowest_bit(matches)) & mask;
+            if (table->keys[index] == key)
+                return index;
+            matches &= matches - 1;
+        }
+
+        // An empty slot ends the probe sequence: the key would have gone there
+        if (group_match(group, CTRL_EMPTY))
+            return -1;
+
+        pos = (pos + step) & mask;
+    }
+}
+
+// First empty or deleted slot on the probe sequence of hash
+static int table_find_free(const IntHashTable *table, uint64_t hash)
+{
+    int mask = table->capacity - 1;
+    int pos = hash_h1(hash, table->capacity);
+
+    for (int step = HASH_GROUP_WIDTH;; step += HASH_GROUP_WIDTH)
+    {
+        unsigned free_slots = group_match_free(table->ctrl + pos);
+        if (free_slots)
+            return (pos + lowest_bit(free_slots)) & mask;
+
+        pos = (pos + step) & mask;
+    }
+}
+
+static void table_rehash(IntHashTable *table, int min_size)
+{
+    IntHashTable old = *table;
+
+    table_init(table, min_size, old.values != NULL);
+
+    for (int i = 0; i < old.capacity; i++)
+    {
+        if (old.ctrl[i] < 0)
+            continue;
+
+        uint64_t hash = hash_int(old.keys[i]);
+        int index = table_find_free(table, hash);
+
+        table_set_ctrl(table, index, hash_h2(hash));
+        table->keys[index] = old.keys[i];
+        if (table->values)
+            table->values[index] = old.values[i];
+    }
+
+    table->size = old.size;
+    table->growth_left -= old.size;
+
+    table_destroy(&old);
+}
+
+static void table_reserve(IntHashTable *table, int min_size)
+{
+    if (min_size > table->size + table->growth_left)
+        table_rehash(table, min_size);
+}
+
+// Returns the slot for key, inserting it if needed. *inserted tells which.
+static int table_insert(IntHashTable *table, int key, bool *inserted)
+{
+    int index = table_find(table, key);
+    if (index >= 0)
+    {
+        *inserted = false;
+        return index;
+    }
+
+    uint64_t hash = hash_int(key);
+    index = table_find_free(table, hash);
+
+    if (table->ctrl[index] == CTRL_EMPTY && table->growth_left == 0)
+    {
+        // Out of empty slots: grow, or just drop the tombstones if the table
+        // is mostly deleted entries.
+        int min_size = table->size + 1;
+        if (table_capacity_for(min_size) == table->capacity && table->size > table->capacity / 2)
+            min_size = table_max_load(table->capacity) + 1;
+
+        table_rehash(table, min_size);
+        index = table_find_free(table, hash);
+    }
+
+    if (table->ctrl[index] == CTRL_EMPTY)
+        table->growth_left--;
+
+    table_set_ctrl(table, index, hash_h2(hash));
+    table->keys[index] = key;
+    table->size++;
+
+    *inserted = true;
+    return index;
+}
+
+static bool table_remove(IntHashTable *table, int key)
+{
+    int index = table_find(table, key);
+    if (index < 0)
+        return false;
+
+    table_set_ctrl(table, index, CTRL_DELETED);
+    table->size--;
+    return true;
+}
+
+// Pulls the control group and key slot for key into cache ahead of its lookup
+static void table_prefetch(const IntHashTable *table, int key)
+{
+    int pos = hash_h1(hash_int(key), table->capacity);
+
+    HASH_PREFETCH(table->ctrl + pos);
+    HASH_PREFETCH(table->keys + pos);
+}
+
+static Vector table_export(const IntHashTable *table, const int *slots)
+{
+    Vector result = vec_create_with_capacity(table->size > 0 ? table->size : DEFAULT_CAPACITY);
+
+    for (int i = 0; i < table->capacity; i++)
+    {
+        if (table->ctrl[i] >= 0)
+            result.data[result.size++] = slots[i];
+    }
+
+    return result;
+}
+
+static void check_non_negative(int value)
+{
+    if (value < 0)
+    {
+        fprintf(stderr, "%d is negative\n", value);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// INTSET (Creation, Membership, Batch Operations, Export)
+// -----------------------------------------------------------------------------
+
+IntSet intset_create()
+{
+    return intset_create_with_capacity(DEFAULT_CAPACITY);
+}
+
+IntSet intset_create_with_capacity(int initial_capacity)
+{
+    check_non_negative(initial_capacity);
+
+    IntSet set;
+    table_init(&set.table, initial_capacity, false);
+    return set;
+}
+
+IntSet intset_from_vector(const Vector *vec)
+{
+    IntSet set = intset_create_with_capacity(vec->size);
+    intset_add_all(&set, vec);
+    return set;
+}
+
+void intset_reserve(IntSet *set, int min_size)
+{
+    table_reserve(&set->table, min_size);
+}
+
+void intset_clear(IntSet *set)
+{
+    table_clear(&set->table);
+}
+
+void intset_destroy(IntSet *set)
+{
+    table_destroy(&set->table);
+}
+
+int intset_size(const IntSet *set)
+{
+    return set->table.size;
+}
+
+bool intset_is_empty(const IntSet *set)
+{
+    return set->table.size == 0;
+}
+
+bool intset_add(IntSet *set, int element)
+{
+    bool inserted;
+    table_insert(&set->table, element, &inserted);
+    return inserted;
+}
+
+bool intset_remove(IntSet *set, int element)
+{
+    return table_remove(&set->table, element);
+}
+
+bool intset_contains(const IntSet *set, int element)
+{
+    return table_find(&set->table, element) >= 0;
+}
+
+void intset_add_all(IntSet *set, const Vector *elements)
+{
+    bool inserted;
+
+    table_reserve(&set->table, set->table.size + elements->size);
+
+    for (int i = 0; i < elements->size; i++)
+    {
+        if (i + HASH_PREFETCH_DISTANCE < elements->size)
+            table_prefetch(&set->table, elements->data[i + HASH_PREFETCH_DISTANCE]);
+
+        table_insert(&set->table, elements->data[i], &inserted);
+    }
+}
+
+void intset_contains_batch(const IntSet *set, const Vector *elements, bool *results)
+{
+    for (int i = 0; i < elements->size; i++)
+    {
+        if (i + HASH_PREFETCH_DISTANCE < elements->size)
+            table_prefetch(&set->table, elements->data[i + HASH_PREFETCH_DISTANCE]);
+
+        results[i] = table_find(&set->table, elements->data[i]) >= 0;
+    }
+}
+
+Vector intset_to_vector(const IntSet *set)
+{
+    return table_export(&set->table, set->table.keys);
+}
+
+// -----------------------------------------------------------------------------
+// INTMAP (Creation, Lookup, Batch Operations, Export)
+// -----------------------------------------------------------------------------
+
+IntMap intmap_create()
+{
+    return intmap_create_with_capacity(DEFAULT_CAPACITY);
+}
+
+IntMap intmap_create_with_capacity(int initial_capacity)
+{
+    check_non_negative(initial_capacity);
+
+    IntMap map;
+    table_init(&map.table, initial_capacity, true);
+    return map;
+}
+
+IntMap intmap_from_vectors(const Vector *keys, const Vector *values)
+{
+    IntMap map = intmap_create_with_capacity(keys->size);
+    intmap_put_all(&map, keys, values);
+    return map;
+}
+
+void intmap_reserve(IntMap *map, int min_size)
+{
+    table_reserve(&map->table, min_size);
+}
+
+void intmap_clear(IntMap *map)
+{
+    table_clear(&map->table);
+}
+
+void intmap_destroy(IntMap *map)
+{
+    table_destroy(&map->table);
+}
+
+int intmap_size(const IntMap *map)
+{
+    return map->table.size;
+}
+
+bool intmap_is_empty(const IntMap *map)
+{
+    return map->table.size == 0;
+}
+
+void intmap_put(IntMap *map, int key, int value)
+{
+    bool inserted;
+    int index = table_insert(&map->table, key, &inserted);
+    map->table.values[index] = value;
+}
+
+int intmap_increment(IntMap *map, int key, int delta)
+{
+    bool inserted;
+    int index = table_insert(&map->table, key, &inserted);
+
+    if (inserted)
+        map->table.values[index] = 0;
+
+    return map->table.values[index] += delta;
+}
+
+bool intmap_get(const IntMap *map, int key, int *value)
+{
+    int index = table_find(&map->table, key);
+    if (index < 0)
+        return false;
+
+    if (value)
+        *value = map->table.values[index];
+    return true;
+}
+
+int intmap_get_or_default(const IntMap *map, int key, int default_value)
+{
+    int index = table_find(&map->table, key);
+    return index >= 0 ? map->table.values[index] : default_value;
+}
+
+bool intmap_contains_key(const IntMap *map, int key)
+{
+    return table_find(&map->table, key) >= 0;
+}
+
+bool intmap_remove(IntMap *map, int key)
+{
+    return table_remove(&map->table, key);
+}
+
+void intmap_put_all(IntMap *map, const Vector *keys, const Vector *values)
+{
+    if (keys->size != values->size)
+    {
+        fprintf(stderr, "Key and value vectors differ in size (keys=%d, values=%d)\n", keys->size, values->size);
+        exit(EXIT_FAILURE);
+    }
+
+    table_reserve(&map->table, map->table.size + keys->size);
+
+    for (int i = 0; i < keys->size; i++)
+    {
+        if (i + HASH_PREFETCH_DISTANCE < keys->size)
+            table_prefetch(&map->table, keys->data[i + HASH_PREFETCH_DISTANCE]);
+
+        intmap_put(map, keys->data[i], values->data[i]);
+    }
+}
+
+void intmap_get_batch(const IntMap *map, const Vector *keys, int *values, bool *found)
+{
+    for (int i = 0; i < keys->size; i++)
+    {
+        if (i + HASH_PREFETCH_DISTANCE < keys->size)
+            table_prefetch(&map->table, keys->data[i + HASH_PREFETCH_DISTANCE]);
+
+        int index = table_find(&map->table, keys->data[i]);
+        values[i] = index >= 0 ? map->table.values[index] : 0;
+        if (found)
+            found[i] = index >= 0;
+    }
+}
+
+Vector intmap_keys(const IntMap *map)
+{
+    return table_export(&map->table, map->table.keys);
+}
+
+Vector intmap_values(const IntMap *map)
+{
+    return table_export(&map->table, map->table.values);
+}
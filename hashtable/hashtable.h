@@ -0,0 +1,89 @@
+#ifndef HASHTABLE_H
+#define HASHTABLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../vector/vector.h"
+
+// Slots are probed in groups of this many control bytes (one SSE2 register)
+#define HASH_GROUP_WIDTH 16
+
+#ifndef HASH_PREFETCH_DISTANCE
+#define HASH_PREFETCH_DISTANCE 8
+#endif
+
+// Open-addressing table in the Swiss table layout: one control byte per slot
+// holds 7 bits of the hash (or an empty/deleted marker), so a lookup compares
+// a whole group of candidates at once before touching any key.
+typedef struct
+{
+    int8_t *ctrl;    // capacity + HASH_GROUP_WIDTH - 1 control bytes
+    int *keys;
+    int *values;     // NULL for sets
+    int size;        // Current number of elements
+    int capacity;    // Number of slots, always a power of two
+    int growth_left; // Inserts into empty slots left before a rehash
+} IntHashTable;
+
+typedef struct
+{
+    IntHashTable table;
+} IntSet;
+
+typedef struct
+{
+    IntHashTable table;
+} IntMap;
+
+// -----------------------------------------------------------------------------
+// INTSET (Creation, Membership, Batch Operations, Export)
+// -----------------------------------------------------------------------------
+
+IntSet intset_create();
+IntSet intset_create_with_capacity(int initial_capacity);
+IntSet intset_from_vector(const Vector *vec);
+void intset_reserve(IntSet *set, int min_size);
+void intset_clear(IntSet *set);
+void intset_destroy(IntSet *set);
+
+int intset_size(const IntSet *set);
+bool intset_is_empty(const IntSet *set);
+
+bool intset_add(IntSet *set, int element);
+bool intset_remove(IntSet *set, int element);
+bool intset_contains(const IntSet *set, int element);
+
+void intset_add_all(IntSet *set, const Vector *elements);
+void intset_contains_batch(const IntSet *set, const Vector *elements, bool *results);
+
+Vector intset_to_vector(const IntSet *set);
+
+// -----------------------------------------------------------------------------
+// INTMAP (Creation, Lookup, Batch Operations, Export)
+// -----------------------------------------------------------------------------
+
+IntMap intmap_create();
+IntMap intmap_create_with_capacity(int initial_capacity);
+IntMap intmap_from_vectors(const Vector *keys, const Vector *values);
+void intmap_reserve(IntMap *map, int min_size);
+void intmap_clear(IntMap *map);
+void intmap_destroy(IntMap *map);
+
+int intmap_size(const IntMap *map);
+bool intmap_is_empty(const IntMap *map);
+
+void intmap_put(IntMap *map, int key, int value);
+int intmap_increment(IntMap *map, int key, int delta);
+bool intmap_get(const IntMap *map, int key, int *value);
+int intmap_get_or_default(const IntMap *map, int key, int default_value);
+bool intmap_contains_key(const IntMap *map, int key);
+bool intmap_remove(IntMap *map, int key);
+
+void intmap_put_all(IntMap *map, const Vector *keys, const Vector *values);
+// Missing keys get 0 in values; pass found to tell them from stored zeros
+void intmap_get_batch(const IntMap *map, const Vector *keys, int *values, bool *found);
+
+Vector intmap_keys(const IntMap *map);
+Vector intmap_values(const IntMap *map);
+
+#endif // HASHTABLE_H
@@ -0,0 +1,208 @@
+#include "heap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// True when a belongs above b in the heap
+static bool heap_before(const VecHeap *heap, int a, int b)
+{
+    return heap->order == HEAP_MIN ? a < b : a > b;
+}
+
+static void heap_sift_up(VecHeap *heap, int index)
+{
+    int *data = heap->items.data;
+    int value = data[index];
+
+    while (index > 0)
+    {
+        int parent = (index - 1) / heap->arity;
+        if (!heap_before(heap, value, data[parent]))
+            break;
+
+        data[index] = data[parent];
+        index = parent;
+    }
+
+    data[index] = value;
+}
+
+static void heap_sift_down(VecHeap *heap, int index)
+{
+    int *data = heap->items.data;
+    int size = heap->items.size;
+    int value = data[index];
+
+    for (;;)
+    {
+        int first = index * heap->arity + 1;
+        if (first >= size)
+            break;
+
+        // Children of a node are contiguous, so a wide node scans one cache line
+        int last = first + heap->arity < size ? first + heap->arity : size;
+        int best = first;
+        for (int child = first + 1; child < last; child++)
+        {
+            if (heap_before(heap, data[child], data[best]))
+                best = child;
+        }
+
+        if (!heap_before(heap, data[best], value))
+            break;
+
+        data[index] = data[best];
+        index = best;
+    }
+
+    data[index] = value;
+}
+
+// Floyd's bottom-up construction: O(n) instead of n pushes at O(log n) each
+static void heap_heapify(VecHeap *heap)
+{
+    if (heap->items.size < 2)
+        return;
+
+    for (int i = (heap->items.size - 2) / heap->arity; i >= 0; i--)
+    {
+        heap_sift_down(heap, i);
+    }
+}
+
+static void heap_check_not_empty(const VecHeap *heap, const char *caller)
+{
+    if (heap->items.size == 0)
+    {
+        fprintf(stderr, "Heap is empty in %s\n", caller);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// CORE MANAGEMENT (Creation, Destruction, Properties)
+// -----------------------------------------------------------------------------
+
+VecHeap heap_create(int arity, HeapOrder order)
+{
+    return heap_create_with_capacity(arity, order, DEFAULT_CAPACITY);
+}
+
+VecHeap heap_create_with_capacity(int arity, HeapOrder order, int initial_capacity)
+{
+    if (arity < 2)
+    {
+        fprintf(stderr, "Heap arity must be at least 2 (arity=%d)\n", arity);
+        exit(EXIT_FAILURE);
+    }
+
+    VecHeap heap;
+    heap.items = vec_create_with_capacity(initial_capacity);
+    heap.arity = arity;
+    heap.order = order;
+    return heap;
+}
+
+VecHeap heap_from_vector(const Vector *vec, int arity, HeapOrder order)
+{
+    VecHeap heap = heap_create_with_capacity(arity, order, vec->size > 0 ? vec->size : DEFAULT_CAPACITY);
+
+    memcpy(heap.items.data, vec->data, vec->size * sizeof(int));
+    heap.items.size = vec->size;
+    heap_heapify(&heap);
+
+    return heap;
+}
+
+void heap_clear(VecHeap *heap)
+{
+    vec_clear(&heap->items);
+}
+
+void heap_destroy(VecHeap *heap)
+{
+    vec_destroy(&heap->items);
+}
+
+int heap_size(const VecHeap *heap)
+{
+    return heap->items.size;
+}
+
+bool heap_is_empty(const VecHeap *heap)
+{
+    return heap->items.size == 0;
+}
+
+// -----------------------------------------------------------------------------
+// PRIORITY QUEUE OPERATIONS (Push, Pop, Peek)
+// -----------------------------------------------------------------------------
+
+void heap_push(VecHeap *heap, int element)
+{
+    vec_add(&heap->items, element);
+    heap_sift_up(heap, heap->items.size - 1);
+}
+
+void heap_push_all(VecHeap *heap, const Vector *elements)
+{
+    int old_size = heap->items.size;
+    int count = elements->size;
+
+    if (count == 0)
+        return;
+
+    vec_ensure_capacity(&heap->items, old_size + count);
+    vec_invalidate(&heap->items);
+    memcpy(&heap->items.data[old_size], elements->data, count * sizeof(int));
+    heap->items.size = old_size + count;
+
+    // Rebuilding is linear in the total size; sifting each new element up
+    // only wins while the batch is small compared to the existing heap.
+    if (count >= old_size)
+    {
+        heap_heapify(heap);
+        return;
+    }
+
+    for (int i = old_size; i < heap->items.size; i++)
+    {
+        heap_sift_up(heap, i);
+    }
+}
+
+int heap_pop(VecHeap *heap)
+{
+    heap_check_not_empty(heap, "heap_pop");
+    vec_invalidate(&heap->items);
+
+    int top = heap->items.data[0];
+    int last = heap->items.data[--heap->items.size];
+
+    if (heap->items.size > 0)
+    {
+        heap->items.data[0] = last;
+        heap_sift_down(heap, 0);
+    }
+
+    return top;
+}
+
+int heap_peek(const VecHeap *heap)
+{
+    heap_check_not_empty(heap, "heap_peek");
+
+    return heap->items.data[0];
+}
+
+int heap_replace_top(VecHeap *heap, int element)
+{
+    heap_check_not_empty(heap, "heap_replace_top");
+    vec_invalidate(&heap->items);
+
+    int top = heap->items.data[0];
+    heap->items.data[0] = element;
+    heap_sift_down(heap, 0);
+
+    return top;
+}
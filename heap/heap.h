@@ -0,0 +1,47 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <stdbool.h>
+#include "../vector/vector.h"
+
+#ifndef HEAP_DEFAULT_ARITY
+#define HEAP_DEFAULT_ARITY 4
+#endif
+
+typedef enum
+{
+    HEAP_MIN, // Smallest element on top
+    HEAP_MAX  // Largest element on top
+} HeapOrder;
+
+typedef struct
+{
+    Vector items;    // Heap-ordered elements, root at index 0
+    int arity;       // Number of children per node (2, 4 or 8 recommended)
+    HeapOrder order; // Which element is kept on top
+} VecHeap;
+
+// -----------------------------------------------------------------------------
+// CORE MANAGEMENT (Creation, Destruction, Properties)
+// -----------------------------------------------------------------------------
+
+VecHeap heap_create(int arity, HeapOrder order);
+VecHeap heap_create_with_capacity(int arity, HeapOrder order, int initial_capacity);
+VecHeap heap_from_vector(const Vector *vec, int arity, HeapOrder order);
+void heap_clear(VecHeap *heap);
+void heap_destroy(VecHeap *heap);
+
+int heap_size(const VecHeap *heap);
+bool heap_is_empty(const VecHeap *heap);
+
+// -----------------------------------------------------------------------------
+// PRIORITY QUEUE OPERATIONS (Push, Pop, Peek)
+// -----------------------------------------------------------------------------
+
+void heap_push(VecHeap *heap, int element);
+void heap_push_all(VecHeap *heap, const Vector *elements);
+int heap_pop(VecHeap *heap);
+int heap_peek(const VecHeap *heap);
+int heap_replace_top(VecHeap *heap, int element);
+
+#endif // HEAP_H
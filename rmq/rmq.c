@@ -0,0 +1,239 @@
+#include "rmq.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int floor_log2(unsigned n)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 31 - __builtin_clz(n);
+#else
+    int log = 0;
+    while (n >>= 1)
+        log++;
+    return log;
+#endif
+}
+
+static int lowest_bit(uint32_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int bit = 0;
+    while (!(mask & 1u))
+    {
+        mask >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+static void *malloc_or_exit(size_t size)
+{
+    void *memory = malloc(size > 0 ? size : 1);
+    if (!memory)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    return memory;
+}
+
+// True when a is strictly preferable to b under the index's mode
+static bool rmq_better(const RmqIndex *rmq, int a, int b)
+{
+    return rmq->mode == RMQ_MIN ? a < b : a > b;
+}
+
+// Picks between two candidate positions, keeping the left one on ties
+static int rmq_pick(const RmqIndex *rmq, int left, int right)
+{
+    return rmq_better(rmq, rmq->values[right], rmq->values[left]) ? right : left;
+}
+
+// Fills rows 1.. of the sparse table from row 0, each row combining two
+// overlapping halves of the row below it
+static void rmq_build_table(RmqIndex *rmq, const int *row0, int width)
+{
+    int levels = width > 0 ? floor_log2(width) + 1 : 1;
+
+    rmq->table_width = width;
+    rmq->table = (int *)malloc_or_exit((size_t)levels * width * sizeof(int));
+    memcpy(rmq->table, row0, width * sizeof(int));
+
+    for (int k = 1; k < levels; k++)
+    {
+        const int *below = rmq->table + (size_t)(k - 1) * width;
+        int *row = rmq->table + (size_t)k * width;
+        int half = 1 << (k - 1);
+
+        for (int i = 0; i + (1 << k) <= width; i++)
+        {
+            row[i] = rmq_pick(rmq, below[i], below[i + half]);
+        }
+    }
+}
+
+// Best element index over table entries [first, last] (inclusive)
+static int rmq_table_query(const RmqIndex *rmq, int first, int last)
+{
+    int k = floor_log2(last - first + 1);
+    const int *row = rmq->table + (size_t)k * rmq->table_width;
+
+    return rmq_pick(rmq, row[first], row[last - (1 << k) + 1]);
+}
+
+// Best element index over [first, last] (inclusive) inside one block: the
+// lowest stack entry at or after first
+static int rmq_block_query(const RmqIndex *rmq, int first, int last)
+{
+    int block_start = last - last % RMQ_BLOCK_SIZE;
+    uint32_t mask = rmq->masks[last] & (~0u << (first - block_start));
+
+    return block_start + lowest_bit(mask);
+}
+
+static RmqIndex rmq_init(const Vector *vec, RmqMode mode, bool compact)
+{
+    RmqIndex rmq;
+    rmq.size = vec->size;
+    rmq.mode = mode;
+    rmq.compact = compact;
+    rmq.masks = NULL;
+    rmq.values = (int *)malloc_or_exit(vec->size * sizeof(int));
+    memcpy(rmq.values, vec->data, vec->size * sizeof(int));
+    return rmq;
+}
+
+// -----------------------------------------------------------------------------
+// CORE MANAGEMENT (Creation, Destruction, Properties)
+// -----------------------------------------------------------------------------
+
+RmqIndex rmq_create(const Vector *vec, RmqMode mode)
+{
+    RmqIndex rmq = rmq_init(vec, mode, false);
+    int *row0 = (int *)malloc_or_exit(vec->size * sizeof(int));
+
+    for (int i = 0; i < vec->size; i++)
+    {
+        row0[i] = i;
+    }
+
+    rmq_build_table(&rmq, row0, vec->size);
+    free(row0);
+
+    return rmq;
+}
+
+RmqIndex rmq_create_compact(const Vector *vec, RmqMode mode)
+{
+    RmqIndex rmq = rmq_init(vec, mode, true);
+    int block_count = (vec->size + RMQ_BLOCK_SIZE - 1) / RMQ_BLOCK_SIZE;
+    int *block_best = (int *)malloc_or_exit(block_count * sizeof(int));
+
+    rmq.masks = (uint32_t *)malloc_or_exit(vec->size * sizeof(uint32_t));
+
+    for (int b = 0; b < block_count; b++)
+    {
+        int start = b * RMQ_BLOCK_SIZE;
+        int end = start + RMQ_BLOCK_SIZE < vec->size ? start + RMQ_BLOCK_SIZE : vec->size;
+        uint32_t stack = 0;
+
+        // Bit p of masks[i] is set when position start + p is still on the
+        // monotonic stack after pushing i; strictly better values pop it.
+        for (int i = start; i < end; i++)
+        {
+            while (stack)
+            {
+                int top = start + floor_log2(stack);
+                if (!rmq_better(&rmq, rmq.values[i], rmq.values[top]))
+                    break;
+                stack &= ~(1u << (top - start));
+            }
+
+            stack |= 1u << (i - start);
+            rmq.masks[i] = stack;
+        }
+
+        block_best[b] = rmq_block_query(&rmq, start, end - 1);
+    }
+
+    rmq_build_table(&rmq, block_best, block_count);
+    free(block_best);
+
+    return rmq;
+}
+
+void rmq_destroy(RmqIndex *rmq)
+{
+    free(rmq->values);
+    free(rmq->table);
+    free(rmq->masks);
+    rmq->values = rmq->table = NULL;
+    rmq->masks = NULL;
+    rmq->size = rmq->table_width = 0;
+}
+
+int rmq_size(const RmqIndex *rmq)
+{
+    return rmq->size;
+}
+
+// -----------------------------------------------------------------------------
+// QUERIES (Single and Batched, over [from_index, to_index))
+// -----------------------------------------------------------------------------
+
+RmqResult rmq_query(const RmqIndex *rmq, int from_index, int to_index)
+{
+    if (from_index < 0 || to_index > rmq->size || from_index >= to_index)
+    {
+        fprintf(stderr, "Invalid range in rmq_query (from=%d, to=%d, size=%d)\n", from_index, to_index, rmq->size);
+        exit(EXIT_FAILURE);
+    }
+
+    int first = from_index;
+    int last = to_index - 1;
+    int best;
+
+    if (!rmq->compact)
+    {
+        best = rmq_table_query(rmq, first, last);
+    }
+    else
+    {
+        int first_block = first / RMQ_BLOCK_SIZE;
+        int last_block = last / RMQ_BLOCK_SIZE;
+
+        if (first_block == last_block)
+        {
+            best = rmq_block_query(rmq, first, last);
+        }
+        else
+        {
+            // Partial head block, whole middle blocks, partial tail block
+            best = rmq_block_query(rmq, first, (first_block + 1) * RMQ_BLOCK_SIZE - 1);
+            if (last_block - first_block > 1)
+                best = rmq_pick(rmq, best, rmq_table_query(rmq, first_block + 1, last_block - 1));
+            best = rmq_pick(rmq, best, rmq_block_query(rmq, last_block * RMQ_BLOCK_SIZE, last));
+        }
+    }
+
+    RmqResult result = {rmq->values[best], best};
+    return result;
+}
+
+void rmq_query_batch(const RmqIndex *rmq, const Vector *from_indices, const Vector *to_indices, RmqResult *results)
+{
+    if (from_indices->size != to_indices->size)
+    {
+        fprintf(stderr, "Range vectors differ in size (from=%d, to=%d)\n", from_indices->size, to_indices->size);
+        exit(EXIT_FAILURE);
+    }
+
+    for (int i = 0; i < from_indices->size; i++)
+    {
+        results[i] = rmq_query(rmq, from_indices->data[i], to_indices->data[i]);
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef RMQ_H
+#define RMQ_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../vector/vector.h"
+
+// Elements per block in the compact layout (one bit each in a uint32_t mask)
+#define RMQ_BLOCK_SIZE 32
+
+typedef enum
+{
+    RMQ_MIN, // Queries return the smallest element
+    RMQ_MAX  // Queries return the largest element
+} RmqMode;
+
+typedef struct
+{
+    int value;
+    int index; // Leftmost position holding value
+} RmqResult;
+
+// Range minimum/maximum query index over a snapshot of a Vector.
+//
+// The default layout is a sparse table: O(n log n) memory, O(1) queries.
+// The compact layout splits the elements into blocks of RMQ_BLOCK_SIZE,
+// answers in-block queries from a per-element bitmask of the monotonic stack
+// and spans of whole blocks from a sparse table over block results: O(n)
+// memory, still O(1) queries.
+typedef struct
+{
+    int *values;     // Copy of the indexed elements
+    int size;        // Number of indexed elements
+    RmqMode mode;    // Minimum or maximum queries
+    bool compact;    // Block-decomposed layout
+    int *table;      // Sparse table of element indices, one row per power of two
+    int table_width; // Entries per row: elements, or blocks when compact
+    uint32_t *masks; // Compact layout only: in-block stack per element
+} RmqIndex;
+
+// -----------------------------------------------------------------------------
+// CORE MANAGEMENT (Creation, Destruction, Properties)
+// -----------------------------------------------------------------------------
+
+RmqIndex rmq_create(const Vector *vec, RmqMode mode);
+RmqIndex rmq_create_compact(const Vector *vec, RmqMode mode);
+void rmq_destroy(RmqIndex *rmq);
+
+int rmq_size(const RmqIndex *rmq);
+
+// -----------------------------------------------------------------------------
+// QUERIES (Single and Batched, over [from_index, to_index))
+// -----------------------------------------------------------------------------
+
+RmqResult rmq_query(const RmqIndex *rmq, int from_index, int to_index);
+void rmq_query_batch(const RmqIndex *rmq, const Vector *from_indices, const Vector *to_indices, RmqResult *results);
+
+#endif // RMQ_H
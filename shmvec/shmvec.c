@@ -0,0 +1,352 @@
+// shm_open, ftruncate and mmap are hidden in strict ISO C modes
+#if !defined(_POSIX_C_SOURCE) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
+#include "shmvec.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SHMVEC_MAGIC 0x56534853u // "SHSV"
+
+// Elements start one cache line in, so the header never shares a line with them
+#define SHMVEC_DATA_OFFSET 64
+
+struct ShmVectorHeader
+{
+    _Atomic uint32_t magic;     // SHMVEC_MAGIC once the segment is initialised
+    uint32_t element_size;      // sizeof(int) of the creating process
+    _Atomic uint64_t sequence;  // Odd while the writer is changing elements in place
+    _Atomic int size;           // Published number of elements
+    _Atomic int capacity;       // Elements the segment currently has room for
+};
+
+_Static_assert(sizeof(struct ShmVectorHeader) <= SHMVEC_DATA_OFFSET, "header must fit before the elements");
+// Processes share the header through the mapping, so the atomics must be
+// plain lock-free memory operations rather than a per-process hidden lock
+_Static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "64-bit atomics must be lock-free for shared memory");
+_Static_assert(ATOMIC_INT_LOCK_FREE == 2, "int atomics must be lock-free for shared memory");
+
+static size_t shmvec_bytes(int capacity)
+{
+    return SHMVEC_DATA_OFFSET + (size_t)capacity * sizeof(int);
+}
+
+static bool shmvec_map(ShmVector *shm, int capacity)
+{
+    int prot = shm->writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void *base = mmap(NULL, shmvec_bytes(capacity), prot, MAP_SHARED, shm->fd, 0);
+    if (base == MAP_FAILED)
+        return false;
+
+    shm->header = (ShmVectorHeader *)base;
+    shm->data = (int *)((char *)base + SHMVEC_DATA_OFFSET);
+    shm->mapped_capacity = capacity;
+    return true;
+}
+
+static void shmvec_unmap(ShmVector *shm)
+{
+    if (shm->header)
+        munmap(shm->header, shmvec_bytes(shm->mapped_capacity));
+    shm->header = NULL;
+    shm->data = NULL;
+    shm->mapped_capacity = 0;
+}
+
+// Closes the descriptor of a failed create/attach and reports error via errno
+static bool shmvec_close_failed(ShmVector *shm, int error)
+{
+    close(shm->fd);
+    shm->fd = -1;
+    errno = error;
+    return false;
+}
+
+static void shmvec_require_writer(const ShmVector *shm)
+{
+    if (!shm->writable)
+    {
+        fprintf(stderr, "Shared vector is attached read-only\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Writer side: extends the segment and remaps it. Existing elements are not
+// touched, so readers keep working on their old (still valid) mappings.
+static void shmvec_grow(ShmVector *shm, int min_capacity)
+{
+    int new_capacity = shm->mapped_capacity * GROW_FACTOR;
+    if (new_capacity < min_capacity)
+        new_capacity = min_capacity;
+    if (new_capacity < DEFAULT_CAPACITY)
+        new_capacity = DEFAULT_CAPACITY;
+
+    if (ftruncate(shm->fd, (off_t)shmvec_bytes(new_capacity)) != 0)
+    {
+        fprintf(stderr, "Shared memory resize failed: %s\n", strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+
+    shmvec_unmap(shm);
+    if (!shmvec_map(shm, new_capacity))
+    {
+        fprintf(stderr, "Shared memory remap failed: %s\n", strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+
+    // Published before any size that needs it, so a reader that sees the
+    // larger size also sees a capacity it can remap to
+    atomic_store_explicit(&shm->header->capacity, new_capacity, memory_order_release);
+}
+
+static void shmvec_ensure_capacity(ShmVector *shm, int min_capacity)
+{
+    if (min_capacity > shm->mapped_capacity)
+        shmvec_grow(shm, min_capacity);
+}
+
+// Reader side: follows the writer's growth once the published size needs it
+static void shmvec_refresh(ShmVector *shm, int size)
+{
+    if (size <= shm->mapped_capacity)
+        return;
+
+    int capacity = atomic_load_explicit(&shm->header->capacity, memory_order_acquire);
+    shmvec_unmap(shm);
+    if (!shmvec_map(shm, capacity))
+    {
+        fprintf(stderr, "Shared memory remap failed: %s\n", strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Brackets an in-place change: odd sequence while elements are inconsistent
+static void shmvec_write_begin(ShmVector *shm)
+{
+    uint64_t sequence = atomic_load_explicit(&shm->header->sequence, memory_order_relaxed);
+    atomic_store_explicit(&shm->header->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+static void shmvec_write_end(ShmVector *shm)
+{
+    uint64_t sequence = atomic_load_explicit(&shm->header->sequence, memory_order_relaxed);
+    atomic_store_explicit(&shm->header->sequence, sequence + 1, memory_order_release);
+}
+
+// -----------------------------------------------------------------------------
+// CORE MANAGEMENT (Create, Attach, Detach, Unlink)
+// -----------------------------------------------------------------------------
+
+bool shmvec_create(ShmVector *shm, const char *name, int initial_capacity)
+{
+    int capacity = initial_capacity > 0 ? initial_capacity : DEFAULT_CAPACITY;
+
+    shm->header = NULL;
+    shm->data = NULL;
+    shm->mapped_capacity = 0;
+    shm->writable = true;
+    shm->fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (shm->fd < 0)
+        return false;
+
+    if (ftruncate(shm->fd, (off_t)shmvec_bytes(capacity)) != 0 || !shmvec_map(shm, capacity))
+    {
+        int error = errno;
+        shm_unlink(name);
+        return shmvec_close_failed(shm, error);
+    }
+
+    ShmVectorHeader *header = shm->header;
+    atomic_init(&header->magic, 0);
+    header->element_size = sizeof(int);
+    atomic_init(&header->sequence, 0);
+    atomic_init(&header->size, 0);
+    atomic_init(&header->capacity, capacity);
+
+    // Readers check the magic first; everything above is visible once it is
+    atomic_store_explicit(&header->magic, SHMVEC_MAGIC, memory_order_release);
+
+    return true;
+}
+
+bool shmvec_attach(ShmVector *shm, const char *name)
+{
+    struct stat info;
+
+    shm->header = NULL;
+    shm->data = NULL;
+    shm->mapped_capacity = 0;
+    shm->writable = false;
+    shm->fd = shm_open(name, O_RDONLY, 0);
+    if (shm->fd < 0)
+        return false;
+
+    if (fstat(shm->fd, &info) != 0)
+        return shmvec_close_failed(shm, errno);
+    if ((size_t)info.st_size < shmvec_bytes(0))
+        return shmvec_close_failed(shm, EINVAL);
+
+    // The file size is at least the capacity the writer has published
+    if (!shmvec_map(shm, (int)(((size_t)info.st_size - SHMVEC_DATA_OFFSET) / sizeof(int))))
+        return shmvec_close_failed(shm, errno);
+
+    if (atomic_load_explicit(&shm->header->magic, memory_order_acquire) != SHMVEC_MAGIC ||
+        shm->header->element_size != sizeof(int))
+    {
+        shmvec_unmap(shm);
+        return shmvec_close_failed(shm, EINVAL);
+    }
+
+    return true;
+}
+
+void shmvec_detach(ShmVector *shm)
+{
+    shmvec_unmap(shm);
+    if (shm->fd >= 0)
+        close(shm->fd);
+    shm->fd = -1;
+}
+
+bool shmvec_unlink(const char *name)
+{
+    return shm_unlink(name) == 0;
+}
+
+int shmvec_size(const ShmVector *shm)
+{
+    return atomic_load_explicit(&shm->header->size, memory_order_acquire);
+}
+
+int shmvec_capacity(const ShmVector *shm)
+{
+    return atomic_load_explicit(&shm->header->capacity, memory_order_acquire);
+}
+
+uint64_t shmvec_sequence(const ShmVector *shm)
+{
+    return atomic_load_explicit(&shm->header->sequence, memory_order_acquire);
+}
+
+// -----------------------------------------------------------------------------
+// WRITER OPERATIONS (Append, Set, Assign, Clear)
+// -----------------------------------------------------------------------------
+
+void shmvec_add(ShmVector *shm, int element)
+{
+    shmvec_require_writer(shm);
+
+    // Only this process stores size, so a relaxed load is enough here
+    int size = atomic_load_explicit(&shm->header->size, memory_order_relaxed);
+    shmvec_ensure_capacity(shm, size + 1);
+
+    shm->data[size] = element;
+    atomic_store_explicit(&shm->header->size, size + 1, memory_order_release);
+}
+
+void shmvec_add_all(ShmVector *shm, const Vector *vec)
+{
+    shmvec_require_writer(shm);
+
+    int size = atomic_load_explicit(&shm->header->size, memory_order_relaxed);
+    shmvec_ensure_capacity(shm, size + vec->size);
+
+    memcpy(shm->data + size, vec->data, vec->size * sizeof(int));
+    atomic_store_explicit(&shm->header->size, size + vec->size, memory_order_release);
+}
+
+void shmvec_set(ShmVector *shm, int index, int element)
+{
+    shmvec_require_writer(shm);
+
+    int size = atomic_load_explicit(&shm->header->size, memory_order_relaxed);
+    if (index < 0 || index >= size)
+    {
+        fprintf(stderr, "Index %d out of bounds for shared vector of size %d\n", index, size);
+        exit(EXIT_FAILURE);
+    }
+
+    shmvec_write_begin(shm);
+    shm->data[index] = element;
+    shmvec_write_end(shm);
+}
+
+void shmvec_assign(ShmVector *shm, const Vector *vec)
+{
+    shmvec_require_writer(shm);
+    shmvec_ensure_capacity(shm, vec->size);
+
+    shmvec_write_begin(shm);
+    memcpy(shm->data, vec->data, vec->size * sizeof(int));
+    atomic_store_explicit(&shm->header->size, vec->size, memory_order_release);
+    shmvec_write_end(shm);
+}
+
+void shmvec_clear(ShmVector *shm)
+{
+    shmvec_require_writer(shm);
+
+    shmvec_write_begin(shm);
+    atomic_store_explicit(&shm->header->size, 0, memory_order_release);
+    shmvec_write_end(shm);
+}
+
+// -----------------------------------------------------------------------------
+// READER OPERATIONS (Zero-Copy Reads, Snapshots)
+// -----------------------------------------------------------------------------
+
+uint64_t shmvec_read_begin(ShmVector *shm, const int **data, int *size)
+{
+    uint64_t sequence;
+
+    // Wait out an in-progress in-place update
+    while ((sequence = atomic_load_explicit(&shm->header->sequence, memory_order_acquire)) & 1u)
+    {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_ia32_pause();
+#endif
+    }
+
+    int published = atomic_load_explicit(&shm->header->size, memory_order_acquire);
+    shmvec_refresh(shm, published);
+
+    *data = shm->data;
+    *size = published;
+    return sequence;
+}
+
+bool shmvec_read_validate(const ShmVector *shm, uint64_t token)
+{
+    // Orders the caller's element reads before the re-check of the sequence
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&shm->header->sequence, memory_order_relaxed) == token;
+}
+
+Vector shmvec_to_vector(ShmVector *shm)
+{
+    Vector result = vec_create();
+
+    for (;;)
+    {
+        const int *data;
+        int size;
+        uint64_t token = shmvec_read_begin(shm, &data, &size);
+
+        vec_ensure_capacity(&result, size);
+        memcpy(result.data, data, size * sizeof(int));
+        result.size = size;
+
+        if (shmvec_read_validate(shm, token))
+            return result;
+    }
+}
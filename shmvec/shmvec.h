@@ -0,0 +1,71 @@
+#ifndef SHMVEC_H
+#define SHMVEC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../vector/vector.h"
+
+// Lives at the start of the segment; defined in shmvec.c
+typedef struct ShmVectorHeader ShmVectorHeader;
+
+// A vector of ints in a named POSIX shared-memory segment (shm_open + mmap),
+// shared between processes on one host without copying.
+//
+// One process creates the segment and is its only writer; any number of
+// processes attach read-only. Appends publish the new size with release
+// semantics, so readers always see a fully written prefix. In-place changes
+// (set, assign, clear) are bracketed by a sequence counter that is odd while
+// the writer is mid-update, letting readers detect and retry torn reads.
+// Growth extends the segment and remaps it; readers remap lazily when the
+// published size outgrows their own mapping.
+typedef struct
+{
+    ShmVectorHeader *header; // Start of this process's mapping
+    int *data;               // Elements, right after the header
+    int mapped_capacity;     // Elements covered by this process's mapping
+    int fd;                  // Segment file descriptor
+    bool writable;           // True for the creating (writer) process
+} ShmVector;
+
+// -----------------------------------------------------------------------------
+// CORE MANAGEMENT (Create, Attach, Detach, Unlink)
+// -----------------------------------------------------------------------------
+
+// Names follow shm_open rules ("/name"). These return false and leave errno
+// set if the segment cannot be created or opened, or is not a shared vector.
+bool shmvec_create(ShmVector *shm, const char *name, int initial_capacity);
+bool shmvec_attach(ShmVector *shm, const char *name);
+void shmvec_detach(ShmVector *shm);
+bool shmvec_unlink(const char *name);
+
+int shmvec_size(const ShmVector *shm);
+int shmvec_capacity(const ShmVector *shm);
+uint64_t shmvec_sequence(const ShmVector *shm);
+
+// -----------------------------------------------------------------------------
+// WRITER OPERATIONS (Append, Set, Assign, Clear)
+// -----------------------------------------------------------------------------
+
+void shmvec_add(ShmVector *shm, int element);
+void shmvec_add_all(ShmVector *shm, const Vector *vec);
+void shmvec_set(ShmVector *shm, int index, int element);
+void shmvec_assign(ShmVector *shm, const Vector *vec);
+void shmvec_clear(ShmVector *shm);
+
+// -----------------------------------------------------------------------------
+// READER OPERATIONS (Zero-Copy Reads, Snapshots)
+// -----------------------------------------------------------------------------
+
+// Zero-copy read: read_begin exposes the elements in place and returns a
+// token; once done, read_validate tells whether the writer changed anything
+// meanwhile (in which case the values seen must be discarded and re-read).
+// read_begin may remap the segment when it has grown, so the pointer it
+// returns is only valid until the next read_begin or shmvec_to_vector call
+// on the same ShmVector; do not keep it across reads.
+uint64_t shmvec_read_begin(ShmVector *shm, const int **data, int *size);
+bool shmvec_read_validate(const ShmVector *shm, uint64_t token);
+
+// Consistent private copy of the current contents
+Vector shmvec_to_vector(ShmVector *shm);
+
+#endif // SHMVEC_H
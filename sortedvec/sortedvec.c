@@ -0,0 +1,348 @@
+#include "sortedvec.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int compare_ints(const void *a, const void *b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Index of the first element of a sorted vector that is >= value
+static int lower_bound(const Vector *run, int value)
+{
+    int left = 0;
+    int right = run->size;
+
+    while (left < right)
+    {
+        int mid = left + (right - left) / 2;
+        if (run->data[mid] < value)
+            left = mid + 1;
+        else
+            right = mid;
+    }
+
+    return left;
+}
+
+static void sortedvec_check_not_empty(const SortedVector *sorted, const char *caller)
+{
+    if (sorted->size == 0)
+    {
+        fprintf(stderr, "Sorted vector is empty in %s\n", caller);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Sorts the buffer and carries it up through the levels
+static void sortedvec_flush(SortedVector *sorted)
+{
+    if (sorted->buffer.size == 0)
+        return;
+
+    qsort(sorted->buffer.data, sorted->buffer.size, sizeof(int), compare_ints);
+
+    Vector carry = sorted->buffer;
+    sorted->buffer = vec_create_with_capacity(SORTED_BUFFER_CAPACITY);
+
+    for (int level = 0; level < SORTED_MAX_LEVELS; level++)
+    {
+        if (sorted->levels[level].size == 0)
+        {
+            vec_destroy(&sorted->levels[level]);
+            sorted->levels[level] = carry;
+            return;
+        }
+
+        Vector merged = vec_merge_unchecked(&sorted->levels[level], &carry);
+        vec_destroy(&carry);
+        vec_destroy(&sorted->levels[level]);
+        carry = merged;
+    }
+
+    fprintf(stderr, "Sorted vector exceeded %d levels\n", SORTED_MAX_LEVELS);
+    exit(EXIT_FAILURE);
+}
+
+// Lowest level whose capacity, SORTED_BUFFER_CAPACITY * 2^level, holds size
+static int sortedvec_level_for(int size)
+{
+    int level = 0;
+    long long capacity = SORTED_BUFFER_CAPACITY;
+
+    while (capacity < size)
+    {
+        capacity *= 2;
+        level++;
+    }
+
+    return level;
+}
+
+// -----------------------------------------------------------------------------
+// CORE MANAGEMENT (Creation, Destruction, Properties)
+// -----------------------------------------------------------------------------
+
+SortedVector sortedvec_create()
+{
+    SortedVector sorted;
+
+    sorted.buffer = vec_create_with_capacity(SORTED_BUFFER_CAPACITY);
+    for (int level = 0; level < SORTED_MAX_LEVELS; level++)
+    {
+        sorted.levels[level] = vec_from_buffer_adopt(NULL, 0, 0);
+    }
+    sorted.size = 0;
+
+    return sorted;
+}
+
+SortedVector sortedvec_from_vector(const Vector *vec)
+{
+    SortedVector sorted = sortedvec_create();
+
+    if (vec->size == 0)
+        return sorted;
+
+    // One sorted run in the level sized for it; later carries reach it as
+    // they would have had the elements been inserted one by one
+    Vector run = vec_subvec(vec, 0, vec->size);
+    qsort(run.data, run.size, sizeof(int), compare_ints);
+
+    sorted.levels[sortedvec_level_for(run.size)] = run;
+    sorted.size = run.size;
+
+    return sorted;
+}
+
+void sortedvec_clear(SortedVector *sorted)
+{
+    vec_clear(&sorted->buffer);
+    for (int level = 0; level < SORTED_MAX_LEVELS; level++)
+    {
+        vec_clear(&sorted->levels[level]);
+    }
+    sorted->size = 0;
+}
+
+void sortedvec_destroy(SortedVector *sorted)
+{
+    vec_destroy(&sorted->buffer);
+    for (int level = 0; level < SORTED_MAX_LEVELS; level++)
+    {
+        vec_destroy(&sorted->levels[level]);
+    }
+    sorted->size = 0;
+}
+
+int sortedvec_size(const SortedVector *sorted)
+{
+    return sorted->size;
+}
+
+bool sortedvec_is_empty(const SortedVector *sorted)
+{
+    return sorted->size == 0;
+}
+
+// -----------------------------------------------------------------------------
+// INSERTION & COMPACTION
+// -----------------------------------------------------------------------------
+
+void sortedvec_insert(SortedVector *sorted, int element)
+{
+    vec_add(&sorted->buffer, element);
+    sorted->size++;
+
+    if (sorted->buffer.size >= SORTED_BUFFER_CAPACITY)
+        sortedvec_flush(sorted);
+}
+
+void sortedvec_insert_all(SortedVector *sorted, const Vector *elements)
+{
+    for (int i = 0; i < elements->size; i++)
+    {
+        sortedvec_insert(sorted, elements->data[i]);
+    }
+}
+
+void sortedvec_compact(SortedVector *sorted)
+{
+    Vector all = sortedvec_to_vector(sorted);
+
+    sortedvec_destroy(sorted);
+    *sorted = sortedvec_create();
+
+    if (all.size == 0)
+    {
+        vec_destroy(&all);
+        return;
+    }
+
+    sorted->levels[sortedvec_level_for(all.size)] = all;
+    sorted->size = all.size;
+}
+
+// -----------------------------------------------------------------------------
+// QUERIES (Lookup, Rank, Range Scans)
+// -----------------------------------------------------------------------------
+
+bool sortedvec_contains(const SortedVector *sorted, int element)
+{
+    if (vec_contains(&sorted->buffer, element))
+        return true;
+
+    for (int level = 0; level < SORTED_MAX_LEVELS; level++)
+    {
+        const Vector *run = &sorted->levels[level];
+        int index = lower_bound(run, element);
+
+        if (index < run->size && run->data[index] == element)
+            return true;
+    }
+
+    return false;
+}
+
+int sortedvec_count(const SortedVector *sorted, int element)
+{
+    int count = vec_count(&sorted->buffer, element);
+
+    for (int level = 0; level < SORTED_MAX_LEVELS; level++)
+    {
+        const Vector *run = &sorted->levels[level];
+        int first = lower_bound(run, element);
+        int last = first;
+
+        while (last < run->size && run->data[last] == element)
+            last++;
+
+        count += last - first;
+    }
+
+    return count;
+}
+
+int sortedvec_rank(const SortedVector *sorted, int element)
+{
+    int rank = 0;
+
+    for (int i = 0; i < sorted->buffer.size; i++)
+    {
+        rank += sorted->buffer.data[i] < element;
+    }
+
+    for (int level = 0; level < SORTED_MAX_LEVELS; level++)
+    {
+        rank += lower_bound(&sorted->levels[level], element);
+    }
+
+    return rank;
+}
+
+int sortedvec_min(const SortedVector *sorted)
+{
+    sortedvec_check_not_empty(sorted, "sortedvec_min");
+
+    bool found = false;
+    int min = 0;
+
+    if (sorted->buffer.size > 0)
+    {
+        min = vec_min(&sorted->buffer);
+        found = true;
+    }
+
+    for (int level = 0; level < SORTED_MAX_LEVELS; level++)
+    {
+        const Vector *run = &sorted->levels[level];
+        if (run->size > 0 && (!found || run->data[0] < min))
+        {
+            min = run->data[0];
+            found = true;
+        }
+    }
+
+    return min;
+}
+
+int sortedvec_max(const SortedVector *sorted)
+{
+    sortedvec_check_not_empty(sorted, "sortedvec_max");
+
+    bool found = false;
+    int max = 0;
+
+    if (sorted->buffer.size > 0)
+    {
+        max = vec_max(&sorted->buffer);
+        found = true;
+    }
+
+    for (int level = 0; level < SORTED_MAX_LEVELS; level++)
+    {
+        const Vector *run = &sorted->levels[level];
+        if (run->size > 0 && (!found || run->data[run->size - 1] > max))
+        {
+            max = run->data[run->size - 1];
+            found = true;
+        }
+    }
+
+    return max;
+}
+
+// Merges the buffer and level elements in [low, high) (all of them when
+// whole is set) into one sorted vector. Level slices are borrowed in place.
+static Vector sortedvec_collect(const SortedVector *sorted, int low, int high, bool whole)
+{
+    Vector slices[SORTED_MAX_LEVELS + 1];
+    int count = 0;
+
+    Vector pending = vec_create_with_capacity(sorted->buffer.size > 0 ? sorted->buffer.size : 1);
+    for (int i = 0; i < sorted->buffer.size; i++)
+    {
+        int value = sorted->buffer.data[i];
+        if (whole || (value >= low && value < high))
+            pending.data[pending.size++] = value;
+    }
+    qsort(pending.data, pending.size, sizeof(int), compare_ints);
+    slices[count++] = pending;
+
+    for (int level = 0; level < SORTED_MAX_LEVELS; level++)
+    {
+        const Vector *run = &sorted->levels[level];
+        int first = whole ? 0 : lower_bound(run, low);
+        int last = whole ? run->size : lower_bound(run, high);
+
+        if (last > first)
+        {
+            Vector slice = {run->data + first, last - first, last - first, 0, NULL};
+            slices[count++] = slice;
+        }
+    }
+
+    Vector result = vec_merge_k_unchecked(slices, count);
+    vec_destroy(&pending);
+
+    return result;
+}
+
+Vector sortedvec_range(const SortedVector *sorted, int low, int high)
+{
+    if (low > high)
+    {
+        fprintf(stderr, "Error: Invalid range: low (%d) is greater than high (%d).\n", low, high);
+        exit(EXIT_FAILURE);
+    }
+
+    return sortedvec_collect(sorted, low, high, false);
+}
+
+Vector sortedvec_to_vector(const SortedVector *sorted)
+{
+    return sortedvec_collect(sorted, 0, 0, true);
+}
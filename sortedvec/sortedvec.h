@@ -0,0 +1,62 @@
+#ifndef SORTEDVEC_H
+#define SORTEDVEC_H
+
+#include <stdbool.h>
+#include "../vector/vector.h"
+
+// Inserts collected before the buffer is sorted and merged into the levels
+#ifndef SORTED_BUFFER_CAPACITY
+#define SORTED_BUFFER_CAPACITY 64
+#endif
+
+#define SORTED_MAX_LEVELS 32
+
+// Log-structured sorted multiset of ints.
+//
+// New elements land in a small unsorted buffer. A full buffer is sorted and
+// carried into the levels like a binary counter: level i is either empty or
+// one sorted run of up to SORTED_BUFFER_CAPACITY * 2^i elements, and a carry
+// into an occupied level merges the two runs and moves up. Every element is
+// merged O(log n) times, so inserts cost O(log n) amortised instead of the
+// O(n) shift of vec_insert_sorted, while each level stays contiguous.
+typedef struct
+{
+    Vector buffer;                    // Recent inserts, unsorted
+    Vector levels[SORTED_MAX_LEVELS]; // Sorted runs, empty or growing geometrically
+    int size;                         // Total number of elements
+} SortedVector;
+
+// -----------------------------------------------------------------------------
+// CORE MANAGEMENT (Creation, Destruction, Properties)
+// -----------------------------------------------------------------------------
+
+SortedVector sortedvec_create();
+SortedVector sortedvec_from_vector(const Vector *vec);
+void sortedvec_clear(SortedVector *sorted);
+void sortedvec_destroy(SortedVector *sorted);
+
+int sortedvec_size(const SortedVector *sorted);
+bool sortedvec_is_empty(const SortedVector *sorted);
+
+// -----------------------------------------------------------------------------
+// INSERTION & COMPACTION
+// -----------------------------------------------------------------------------
+
+void sortedvec_insert(SortedVector *sorted, int element);
+void sortedvec_insert_all(SortedVector *sorted, const Vector *elements);
+void sortedvec_compact(SortedVector *sorted);
+
+// -----------------------------------------------------------------------------
+// QUERIES (Lookup, Rank, Range Scans)
+// -----------------------------------------------------------------------------
+
+bool sortedvec_contains(const SortedVector *sorted, int element);
+int sortedvec_count(const SortedVector *sorted, int element);
+int sortedvec_rank(const SortedVector *sorted, int element);
+int sortedvec_min(const SortedVector *sorted);
+int sortedvec_max(const SortedVector *sorted);
+
+Vector sortedvec_range(const SortedVector *sorted, int low, int high);
+Vector sortedvec_to_vector(const SortedVector *sorted);
+
+#endif // SORTEDVEC_H
@@ -0,0 +1,452 @@
+#include "strvec.h"
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STRVEC_MAGIC 0x56525453u // "STRV"
+
+typedef struct
+{
+    uint64_t prefix;  // First eight bytes, big-endian, zero padded
+    const char *text;
+    int length;
+    int index;
+} StrSortEntry;
+
+static void strvec_check_index(const StrVector *vec, int index)
+{
+    if (index < 0 || index >= strvec_size(vec))
+    {
+        fprintf(stderr, "Index %d is out of range [0..%d]\n", index, strvec_size(vec));
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Makes room for extra more arena bytes
+static void strvec_reserve_bytes(StrVector *vec, int extra)
+{
+    if (extra > INT32_MAX - vec->byte_count)
+    {
+        fprintf(stderr, "String arena exceeds %d bytes\n", INT32_MAX);
+        exit(EXIT_FAILURE);
+    }
+
+    int required = vec->byte_count + extra;
+    if (required <= vec->byte_capacity)
+        return;
+
+    int new_capacity = vec->byte_capacity > 0 ? vec->byte_capacity : DEFAULT_CAPACITY;
+    while (new_capacity < required)
+    {
+        new_capacity = new_capacity > INT32_MAX / GROW_FACTOR ? required : new_capacity * GROW_FACTOR;
+    }
+
+    char *new_bytes = (char *)realloc(vec->bytes, new_capacity);
+    if (!new_bytes)
+    {
+        fprintf(stderr, "Memory re-allocation failed during resize\n");
+        exit(EXIT_FAILURE);
+    }
+    vec->bytes = new_bytes;
+    vec->byte_capacity = new_capacity;
+}
+
+// Seals the bytes written since the last string as a new element
+static void strvec_commit(StrVector *vec, int length)
+{
+    vec->bytes[vec->byte_count + length] = '\0';
+    vec->byte_count += length + 1;
+    vec_add(&vec->offsets, vec->byte_count);
+}
+
+static int strvec_length(const StrVector *vec, int index)
+{
+    return vec->offsets.data[index + 1] - vec->offsets.data[index] - 1;
+}
+
+// -----------------------------------------------------------------------------
+// CORE MANAGEMENT (Creation, Destruction, Properties)
+// -----------------------------------------------------------------------------
+
+StrVector strvec_create()
+{
+    return strvec_create_with_capacity(DEFAULT_CAPACITY, DEFAULT_CAPACITY * 16);
+}
+
+StrVector strvec_create_with_capacity(int initial_count, int initial_bytes)
+{
+    StrVector vec;
+    vec.bytes = NULL;
+    vec.byte_count = 0;
+    vec.byte_capacity = 0;
+    vec.offsets = vec_create_with_capacity(initial_count > 0 ? initial_count + 1 : DEFAULT_CAPACITY);
+    vec_add(&vec.offsets, 0);
+
+    strvec_reserve_bytes(&vec, initial_bytes > 0 ? initial_bytes : DEFAULT_CAPACITY);
+    return vec;
+}
+
+void strvec_clear(StrVector *vec)
+{
+    vec->byte_count = 0;
+    vec_clear(&vec->offsets);
+    vec_add(&vec->offsets, 0);
+}
+
+void strvec_destroy(StrVector *vec)
+{
+    free(vec->bytes);
+    vec->bytes = NULL;
+    vec->byte_count = vec->byte_capacity = 0;
+    vec_destroy(&vec->offsets);
+}
+
+int strvec_size(const StrVector *vec)
+{
+    return vec->offsets.size - 1;
+}
+
+int strvec_byte_count(const StrVector *vec)
+{
+    return vec->byte_count;
+}
+
+// -----------------------------------------------------------------------------
+// ELEMENT ACCESS & MODIFICATION (Append, Get, Search)
+// -----------------------------------------------------------------------------
+
+void strvec_add(StrVector *vec, const char *str)
+{
+    strvec_add_n(vec, str, (int)strlen(str));
+}
+
+void strvec_add_n(StrVector *vec, const char *data, int length)
+{
+    if (length < 0)
+    {
+        fprintf(stderr, "%d is negative\n", length);
+        exit(EXIT_FAILURE);
+    }
+
+    // data may point into this arena, which growing can move
+    uintptr_t at = (uintptr_t)data - (uintptr_t)vec->bytes;
+    bool inside = vec->bytes && at < (uintptr_t)vec->byte_count;
+
+    strvec_reserve_bytes(vec, length + 1);
+    if (inside)
+        data = vec->bytes + at;
+    memcpy(vec->bytes + vec->byte_count, data, length);
+    strvec_commit(vec, length);
+}
+
+void strvec_add_all(StrVector *vec, const StrVector *other)
+{
+    int base = vec->byte_count;
+    int count = strvec_size(other);
+
+    // One copy for the whole arena, then shifted offsets
+    strvec_reserve_bytes(vec, other->byte_count);
+    memcpy(vec->bytes + base, other->bytes, other->byte_count);
+    vec->byte_count += other->byte_count;
+
+    int *offsets = vec_reserve_back(&vec->offsets, count);
+    for (int i = 0; i < count; i++)
+    {
+        offsets[i] = base + other->offsets.data[i + 1];
+    }
+    vec_commit_back(&vec->offsets, count);
+}
+
+StrView strvec_get(const StrVector *vec, int index)
+{
+    strvec_check_index(vec, index);
+
+    StrView view = {vec->bytes + vec->offsets.data[index], strvec_length(vec, index)};
+    return view;
+}
+
+int strvec_indexof(const StrVector *vec, const char *str)
+{
+    int length = (int)strlen(str);
+
+    for (int i = 0; i < strvec_size(vec); i++)
+    {
+        // Length first: most mismatches never touch the bytes
+        if (strvec_length(vec, i) == length && memcmp(vec->bytes + vec->offsets.data[i], str, length) == 0)
+            return i;
+    }
+
+    return -1;
+}
+
+// -----------------------------------------------------------------------------
+// TRANSFORMATION & ORDERING (Filter, Map, Gather, Sort)
+// -----------------------------------------------------------------------------
+
+StrVector strvec_filter(const StrVector *vec, StrPredicate predicate)
+{
+    StrVector result = strvec_create_with_capacity(strvec_size(vec), vec->byte_count);
+
+    for (int i = 0; i < strvec_size(vec); i++)
+    {
+        StrView view = {vec->bytes + vec->offsets.data[i], strvec_length(vec, i)};
+        if (predicate(view))
+            strvec_add_n(&result, view.data, view.length);
+    }
+
+    return result;
+}
+
+StrVector strvec_map(const StrVector *vec, StrMapper mapper)
+{
+    StrVector result = strvec_create_with_capacity(strvec_size(vec), vec->byte_count);
+
+    for (int i = 0; i < strvec_size(vec); i++)
+    {
+        StrView view = {vec->bytes + vec->offsets.data[i], strvec_length(vec, i)};
+
+        // Map straight into the arena tail; retry once if it did not fit
+        int room = result.byte_capacity - result.byte_count - 1;
+        int length = mapper(view, result.bytes + result.byte_count, room > 0 ? room : 0);
+        if (length < 0)
+        {
+            fprintf(stderr, "Mapper returned negative length %d\n", length);
+            exit(EXIT_FAILURE);
+        }
+
+        if (length > room)
+        {
+            strvec_reserve_bytes(&result, length + 1);
+            mapper(view, result.bytes + result.byte_count, length);
+        }
+
+        strvec_commit(&result, length);
+    }
+
+    return result;
+}
+
+StrVector strvec_gather(const StrVector *vec, const Vector *indices)
+{
+    int bytes = 0;
+
+    for (int k = 0; k < indices->size; k++)
+    {
+        strvec_check_index(vec, indices->data[k]);
+        bytes += strvec_length(vec, indices->data[k]) + 1;
+    }
+
+    StrVector result = strvec_create_with_capacity(indices->size, bytes);
+
+    for (int k = 0; k < indices->size; k++)
+    {
+        int i = indices->data[k];
+        strvec_add_n(&result, vec->bytes + vec->offsets.data[i], strvec_length(vec, i));
+    }
+
+    return result;
+}
+
+static int compare_entries(const void *a, const void *b)
+{
+    const StrSortEntry *x = (const StrSortEntry *)a;
+    const StrSortEntry *y = (const StrSortEntry *)b;
+    int shorter = x->length < y->length ? x->length : y->length;
+    int order = memcmp(x->text, y->text, shorter);
+
+    if (order != 0)
+        return order;
+    return (x->length > y->length) - (x->length < y->length);
+}
+
+Vector strvec_argsort(const StrVector *vec)
+{
+    int n = strvec_size(vec);
+    Vector order = vec_create_with_capacity(n > 0 ? n : DEFAULT_CAPACITY);
+    StrSortEntry *entries = (StrSortEntry *)malloc((n > 0 ? n : 1) * sizeof(StrSortEntry));
+    StrSortEntry *scratch = (StrSortEntry *)malloc((n > 0 ? n : 1) * sizeof(StrSortEntry));
+    if (!entries || !scratch)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        const unsigned char *text = (const unsigned char *)vec->bytes + vec->offsets.data[i];
+        int length = strvec_length(vec, i);
+        uint64_t prefix = 0;
+
+        for (int b = 0; b < 8; b++)
+        {
+            prefix = (prefix << 8) | (b < length ? text[b] : 0);
+        }
+
+        entries[i].prefix = prefix;
+        entries[i].text = (const char *)text;
+        entries[i].length = length;
+        entries[i].index = i;
+    }
+
+    // LSD radix sort on the cached prefixes, one byte per pass; passes where
+    // every prefix shares the byte are skipped
+    for (int shift = 0; shift < 64 && n > 0; shift += 8)
+    {
+        int counts[256] = {0};
+
+        for (int i = 0; i < n; i++)
+        {
+            counts[(entries[i].prefix >> shift) & 0xFF]++;
+        }
+
+        if (counts[(entries[0].prefix >> shift) & 0xFF] == n)
+            continue;
+
+        int offset = 0;
+        for (int d = 0; d < 256; d++)
+        {
+            int count = counts[d];
+            counts[d] = offset;
+            offset += count;
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            scratch[counts[(entries[i].prefix >> shift) & 0xFF]++] = entries[i];
+        }
+
+        StrSortEntry *swap = entries;
+        entries = scratch;
+        scratch = swap;
+    }
+
+    // Only runs sharing all eight prefix bytes need the full comparison
+    for (int start = 0; start < n;)
+    {
+        int end = start + 1;
+        while (end < n && entries[end].prefix == entries[start].prefix)
+            end++;
+
+        if (end - start > 1)
+            qsort(entries + start, end - start, sizeof(StrSortEntry), compare_entries);
+        start = end;
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        order.data[i] = entries[i].index;
+    }
+    order.size = n;
+
+    free(entries);
+    free(scratch);
+    return order;
+}
+
+void strvec_sort(StrVector *vec)
+{
+    Vector order = strvec_argsort(vec);
+    StrVector sorted = strvec_gather(vec, &order);
+
+    vec_destroy(&order);
+    strvec_destroy(vec);
+    *vec = sorted;
+}
+
+// -----------------------------------------------------------------------------
+// PERSISTENCE (Binary Save / Load)
+// -----------------------------------------------------------------------------
+
+// File layout: magic, string count, arena byte count, count + 1 offsets, arena
+bool strvec_save(const StrVector *vec, const char *path)
+{
+    FILE *file = fopen(path, "wb");
+    if (!file)
+        return false;
+
+    uint32_t header[3] = {STRVEC_MAGIC, (uint32_t)strvec_size(vec), (uint32_t)vec->byte_count};
+    bool ok = fwrite(header, sizeof(header), 1, file) == 1 &&
+              fwrite(vec->offsets.data, sizeof(int), vec->offsets.size, file) == (size_t)vec->offsets.size &&
+              fwrite(vec->bytes, 1, vec->byte_count, file) == (size_t)vec->byte_count;
+
+    int error = errno;
+    if (fclose(file) != 0 && ok)
+        return false;
+    errno = error;
+    return ok;
+}
+
+bool strvec_load(StrVector *vec, const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+        return false;
+
+    uint32_t header[3];
+    if (fread(header, sizeof(header), 1, file) != 1 || header[0] != STRVEC_MAGIC ||
+        header[1] >= (uint32_t)INT32_MAX || header[2] > (uint32_t)INT32_MAX)
+    {
+        fclose(file);
+        errno = EINVAL;
+        return false;
+    }
+
+    // The sizes must match the file before they size any allocation, so a
+    // truncated or crafted header cannot request gigabytes
+    long length = -1;
+    if (fseek(file, 0, SEEK_END) == 0)
+        length = ftell(file);
+    if (length < 0 || fseek(file, (long)sizeof(header), SEEK_SET) != 0)
+    {
+        int error = errno;
+        fclose(file);
+        errno = error;
+        return false;
+    }
+
+    uint64_t expected = sizeof(header) + ((uint64_t)header[1] + 1) * sizeof(int) + header[2];
+    if ((uint64_t)length != expected)
+    {
+        fclose(file);
+        errno = EINVAL;
+        return false;
+    }
+
+    int count = (int)header[1];
+    int bytes = (int)header[2];
+    StrVector loaded = strvec_create_with_capacity(count, bytes);
+
+    // Two bulk reads straight into the final buffers; the file repeats the
+    // leading 0 offset, so it overwrites the one already there
+    vec_reserve_back(&loaded.offsets, count);
+    bool ok = fread(loaded.offsets.data, sizeof(int), count + 1, file) == (size_t)count + 1 &&
+              fread(loaded.bytes, 1, bytes, file) == (size_t)bytes;
+    fclose(file);
+
+    if (ok)
+    {
+        vec_commit_back(&loaded.offsets, count);
+        loaded.byte_count = bytes;
+
+        // Offsets must rise, end on the arena size and cover NUL-terminated strings
+        ok = loaded.offsets.data[0] == 0 && loaded.offsets.data[count] == bytes;
+        for (int i = 0; ok && i < count; i++)
+        {
+            int end = loaded.offsets.data[i + 1];
+            ok = end > loaded.offsets.data[i] && end <= bytes && loaded.bytes[end - 1] == '\0';
+        }
+    }
+
+    if (!ok)
+    {
+        strvec_destroy(&loaded);
+        errno = EINVAL;
+        return false;
+    }
+
+    strvec_destroy(vec);
+    *vec = loaded;
+    return true;
+}
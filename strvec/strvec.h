@@ -0,0 +1,81 @@
+#ifndef STRVEC_H
+#define STRVEC_H
+
+#include <stdbool.h>
+#include "../vector/vector.h"
+
+// A string inside a StrVector: length bytes at data, followed by a NUL, so
+// data is also a valid C string. Valid until the vector next changes.
+typedef struct
+{
+    const char *data;
+    int length;
+} StrView;
+
+// Vector of strings packed back to back in one growing byte arena. String i
+// occupies bytes [offsets[i], offsets[i + 1] - 1) plus a NUL terminator;
+// offsets always holds size + 1 entries, so appending never allocates per
+// string and lengths are a subtraction.
+typedef struct
+{
+    char *bytes;        // Arena of NUL-terminated strings
+    int byte_count;     // Arena bytes in use
+    int byte_capacity;  // Arena bytes allocated
+    Vector offsets;     // Start of each string, plus the end of the last
+} StrVector;
+
+typedef bool (*StrPredicate)(StrView value);
+
+// Writes the mapped value of `value` into out (up to capacity bytes) and
+// returns its full length; if that exceeds capacity, it is called again with
+// enough room. Same contract as snprintf, minus the terminator.
+typedef int (*StrMapper)(StrView value, char *out, int capacity);
+
+// -----------------------------------------------------------------------------
+// CORE MANAGEMENT (Creation, Destruction, Properties)
+// -----------------------------------------------------------------------------
+
+StrVector strvec_create();
+StrVector strvec_create_with_capacity(int initial_count, int initial_bytes);
+void strvec_clear(StrVector *vec);
+void strvec_destroy(StrVector *vec);
+
+int strvec_size(const StrVector *vec);
+int strvec_byte_count(const StrVector *vec);
+
+// -----------------------------------------------------------------------------
+// ELEMENT ACCESS & MODIFICATION (Append, Get, Search)
+// -----------------------------------------------------------------------------
+
+void strvec_add(StrVector *vec, const char *str);
+void strvec_add_n(StrVector *vec, const char *data, int length);
+void strvec_add_all(StrVector *vec, const StrVector *other);
+
+StrView strvec_get(const StrVector *vec, int index);
+int strvec_indexof(const StrVector *vec, const char *str);
+
+// -----------------------------------------------------------------------------
+// TRANSFORMATION & ORDERING (Filter, Map, Gather, Sort)
+// -----------------------------------------------------------------------------
+
+StrVector strvec_filter(const StrVector *vec, StrPredicate predicate);
+StrVector strvec_map(const StrVector *vec, StrMapper mapper);
+StrVector strvec_gather(const StrVector *vec, const Vector *indices);
+
+// Bytewise (memcmp) order: shorter strings sort before their extensions
+Vector strvec_argsort(const StrVector *vec);
+void strvec_sort(StrVector *vec);
+
+// -----------------------------------------------------------------------------
+// PERSISTENCE (Binary Save / Load)
+// -----------------------------------------------------------------------------
+
+// Native-endian image of the offsets and the arena. Both return false and
+// leave errno set on I/O errors or a malformed file.
+// strvec_load replaces the contents of an initialised vector and frees the
+// old ones only on success; on failure the vector is left untouched. The
+// header's sizes are checked against the file length before allocating.
+bool strvec_save(const StrVector *vec, const char *path);
+bool strvec_load(StrVector *vec, const char *path);
+
+#endif // STRVEC_H
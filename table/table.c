@@ -0,0 +1,302 @@
+#include "table.h"
+#include "../hashtable/hashtable.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void *table_alloc(size_t size)
+{
+    void *memory = malloc(size > 0 ? size : 1);
+    if (!memory)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    return memory;
+}
+
+static int table_require_column(const Table *table, const char *name)
+{
+    int index = table_column_index(table, name);
+    if (index < 0)
+    {
+        fprintf(stderr, "Unknown column \"%s\"\n", name);
+        exit(EXIT_FAILURE);
+    }
+    return index;
+}
+
+static Vector table_rows_of(int count)
+{
+    return vec_create_with_capacity(count > 0 ? count : DEFAULT_CAPACITY);
+}
+
+// Writes every candidate row index and advances only when COND holds: no
+// branch in the loop, so it vectorises and never mispredicts.
+#define TABLE_SELECT_LOOP(COUNT, ROW, COND) \
+    for (int k = 0; k < (COUNT); k++)       \
+    {                                       \
+        int row = (ROW);                    \
+        out[selected] = row;                \
+        selected += (COND);                 \
+    }
+
+// Evaluates data[row] op value for rows 0..count-1, or for the rows listed
+// in candidates when it is non-NULL, writing the passing rows into out
+static int table_compare_rows(const int *data, const int *candidates, int count, TableCompare op, int value, int *out)
+{
+    int selected = 0;
+
+    if (candidates)
+    {
+        switch (op)
+        {
+        case TABLE_EQ: TABLE_SELECT_LOOP(count, candidates[k], data[row] == value) break;
+        case TABLE_NE: TABLE_SELECT_LOOP(count, candidates[k], data[row] != value) break;
+        case TABLE_LT: TABLE_SELECT_LOOP(count, candidates[k], data[row] < value) break;
+        case TABLE_LE: TABLE_SELECT_LOOP(count, candidates[k], data[row] <= value) break;
+        case TABLE_GT: TABLE_SELECT_LOOP(count, candidates[k], data[row] > value) break;
+        case TABLE_GE: TABLE_SELECT_LOOP(count, candidates[k], data[row] >= value) break;
+        }
+    }
+    else
+    {
+        switch (op)
+        {
+        case TABLE_EQ: TABLE_SELECT_LOOP(count, k, data[row] == value) break;
+        case TABLE_NE: TABLE_SELECT_LOOP(count, k, data[row] != value) break;
+        case TABLE_LT: TABLE_SELECT_LOOP(count, k, data[row] < value) break;
+        case TABLE_LE: TABLE_SELECT_LOOP(count, k, data[row] <= value) break;
+        case TABLE_GT: TABLE_SELECT_LOOP(count, k, data[row] > value) break;
+        case TABLE_GE: TABLE_SELECT_LOOP(count, k, data[row] >= value) break;
+        }
+    }
+
+    return selected;
+}
+
+// -----------------------------------------------------------------------------
+// CORE MANAGEMENT (Creation, Destruction, Columns, Rows)
+// -----------------------------------------------------------------------------
+
+Table table_create()
+{
+    Table table;
+    table.names = NULL;
+    table.columns = NULL;
+    table.column_count = 0;
+    table.column_capacity = 0;
+    table.row_count = 0;
+    return table;
+}
+
+void table_destroy(Table *table)
+{
+    for (int c = 0; c < table->column_count; c++)
+    {
+        free(table->names[c]);
+        vec_destroy(&table->columns[c]);
+    }
+
+    free(table->names);
+    free(table->columns);
+    *table = table_create();
+}
+
+int table_add_column(Table *table, const char *name)
+{
+    if (table_column_index(table, name) >= 0)
+    {
+        fprintf(stderr, "Column \"%s\" already exists\n", name);
+        exit(EXIT_FAILURE);
+    }
+
+    if (table->column_count == table->column_capacity)
+    {
+        int new_capacity = table->column_capacity > 0 ? table->column_capacity * GROW_FACTOR : 4;
+        char **names = (char **)realloc(table->names, new_capacity * sizeof(char *));
+        Vector *columns = (Vector *)realloc(table->columns, new_capacity * sizeof(Vector));
+        if (!names || !columns)
+        {
+            fprintf(stderr, "Memory re-allocation failed during resize\n");
+            exit(EXIT_FAILURE);
+        }
+        table->names = names;
+        table->columns = columns;
+        table->column_capacity = new_capacity;
+    }
+
+    size_t length = strlen(name) + 1;
+    int index = table->column_count++;
+
+    table->names[index] = (char *)table_alloc(length);
+    memcpy(table->names[index], name, length);
+
+    // Columns added to a non-empty table start out as zeros
+    table->columns[index] = table_rows_of(table->row_count);
+    vec_fill(&table->columns[index], table->row_count, 0);
+
+    return index;
+}
+
+int table_column_index(const Table *table, const char *name)
+{
+    for (int c = 0; c < table->column_count; c++)
+    {
+        if (strcmp(table->names[c], name) == 0)
+            return c;
+    }
+    return -1;
+}
+
+const Vector *table_column(const Table *table, const char *name)
+{
+    return &table->columns[table_require_column(table, name)];
+}
+
+int table_column_count(const Table *table)
+{
+    return table->column_count;
+}
+
+int table_row_count(const Table *table)
+{
+    return table->row_count;
+}
+
+void table_append_row(Table *table, const int *values)
+{
+    for (int c = 0; c < table->column_count; c++)
+    {
+        vec_add(&table->columns[c], values[c]);
+    }
+    table->row_count++;
+}
+
+// -----------------------------------------------------------------------------
+// SELECTION & GATHER (Column Predicates, Row Materialisation)
+// -----------------------------------------------------------------------------
+
+Vector table_select(const Table *table, const char *column, TableCompare op, int value)
+{
+    const Vector *col = table_column(table, column);
+    Vector selection = table_rows_of(table->row_count);
+
+    selection.size = table_compare_rows(col->data, NULL, table->row_count, op, value, selection.data);
+    return selection;
+}
+
+Vector table_select_where(const Table *table, const char *column, Predicate predicate)
+{
+    const Vector *col = table_column(table, column);
+    Vector selection = table_rows_of(table->row_count);
+    int *out = selection.data;
+    int selected = 0;
+
+    TABLE_SELECT_LOOP(table->row_count, k, predicate(col->data[row]) ? 1 : 0)
+
+    selection.size = selected;
+    return selection;
+}
+
+Vector table_refine(const Table *table, const Vector *selection, const char *column, TableCompare op, int value)
+{
+    const Vector *col = table_column(table, column);
+    Vector refined = table_rows_of(selection->size);
+
+    refined.size = table_compare_rows(col->data, selection->data, selection->size, op, value, refined.data);
+    return refined;
+}
+
+Table table_gather(const Table *table, const Vector *selection)
+{
+    Table result = table_create();
+
+    for (int c = 0; c < table->column_count; c++)
+    {
+        table_add_column(&result, table->names[c]);
+
+        // Column at a time: one sequential write stream per column
+        const int *in = table->columns[c].data;
+        Vector *out = &result.columns[c];
+
+        vec_ensure_capacity(out, selection->size);
+        for (int k = 0; k < selection->size; k++)
+        {
+            out->data[k] = in[selection->data[k]];
+        }
+        out->size = selection->size;
+    }
+
+    result.row_count = selection->size;
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+// GROUPED AGGREGATION (Count, Sum, Min, Max per Key)
+// -----------------------------------------------------------------------------
+
+Table table_group_by(const Table *table, const Vector *selection, const char *key_column, const char *value_column,
+                     long long **sums_out)
+{
+    const int *keys = table_column(table, key_column)->data;
+    const int *values = table_column(table, value_column)->data;
+    int rows = selection ? selection->size : table->row_count;
+
+    Table result = table_create();
+    int key_col = table_add_column(&result, "key");
+    int count_col = table_add_column(&result, "count");
+    int sum_col = table_add_column(&result, "sum");
+    int min_col = table_add_column(&result, "min");
+    int max_col = table_add_column(&result, "max");
+
+    // Key -> output row; aggregates are updated in place in the columns,
+    // except sums which are widened until every row has been added
+    IntMap groups = intmap_create();
+    long long *sums = (long long *)table_alloc((size_t)rows * sizeof(long long));
+
+    for (int k = 0; k < rows; k++)
+    {
+        int row = selection ? selection->data[k] : k;
+        int key = keys[row];
+        int value = values[row];
+        int group;
+
+        if (!intmap_get(&groups, key, &group))
+        {
+            group = result.row_count;
+            intmap_put(&groups, key, group);
+
+            int fresh[5];
+            fresh[key_col] = key;
+            fresh[count_col] = 0;
+            fresh[sum_col] = 0;
+            fresh[min_col] = value;
+            fresh[max_col] = value;
+            table_append_row(&result, fresh);
+            sums[group] = 0;
+        }
+
+        result.columns[count_col].data[group]++;
+        sums[group] += value;
+        if (value < result.columns[min_col].data[group])
+            result.columns[min_col].data[group] = value;
+        if (value > result.columns[max_col].data[group])
+            result.columns[max_col].data[group] = value;
+    }
+
+    // The int column saturates; the exact totals go to the caller on request
+    for (int group = 0; group < result.row_count; group++)
+    {
+        long long sum = sums[group];
+        result.columns[sum_col].data[group] = sum > INT_MAX ? INT_MAX : sum < INT_MIN ? INT_MIN : (int)sum;
+    }
+
+    if (sums_out)
+        *sums_out = sums;
+    else
+        free(sums);
+    intmap_destroy(&groups);
+    return result;
+}
@@ -0,0 +1,67 @@
+#ifndef TABLE_H
+#define TABLE_H
+
+#include <stdbool.h>
+#include "../vector/vector.h"
+
+typedef enum
+{
+    TABLE_EQ,
+    TABLE_NE,
+    TABLE_LT,
+    TABLE_LE,
+    TABLE_GT,
+    TABLE_GE
+} TableCompare;
+
+// Columnar table of named int columns, one Vector per column, all holding
+// row_count elements. Filters produce selection vectors (ascending row
+// indices) so one predicate evaluation drives every column and rows stay
+// aligned.
+typedef struct
+{
+    char **names;        // Column names, owned by the table
+    Vector *columns;     // One vector per column
+    int column_count;    // Number of columns
+    int column_capacity; // Allocated column slots
+    int row_count;       // Number of rows
+} Table;
+
+// -----------------------------------------------------------------------------
+// CORE MANAGEMENT (Creation, Destruction, Columns, Rows)
+// -----------------------------------------------------------------------------
+
+Table table_create();
+void table_destroy(Table *table);
+
+int table_add_column(Table *table, const char *name);
+int table_column_index(const Table *table, const char *name);
+const Vector *table_column(const Table *table, const char *name);
+int table_column_count(const Table *table);
+int table_row_count(const Table *table);
+
+void table_append_row(Table *table, const int *values);
+
+// -----------------------------------------------------------------------------
+// SELECTION & GATHER (Column Predicates, Row Materialisation)
+// -----------------------------------------------------------------------------
+
+Vector table_select(const Table *table, const char *column, TableCompare op, int value);
+Vector table_select_where(const Table *table, const char *column, Predicate predicate);
+Vector table_refine(const Table *table, const Vector *selection, const char *column, TableCompare op, int value);
+
+Table table_gather(const Table *table, const Vector *selection);
+
+// -----------------------------------------------------------------------------
+// GROUPED AGGREGATION (Count, Sum, Min, Max per Key)
+// -----------------------------------------------------------------------------
+
+// Returns a table with columns "key", "count", "sum", "min" and "max", one row
+// per distinct key in order of first appearance. A NULL selection means
+// every row. Sums are accumulated in 64 bits; the int "sum" column saturates
+// at INT_MIN / INT_MAX. Unless sums_out is NULL, *sums_out receives a
+// heap-allocated array of the exact sums, one per row, which the caller frees.
+Table table_group_by(const Table *table, const Vector *selection, const char *key_column, const char *value_column,
+                     long long **sums_out);
+
+#endif // TABLE_H
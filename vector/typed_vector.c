@@ -0,0 +1,5 @@
+#include "typed_vector.h"
+
+IMPLEMENT_VECTOR(long long, LongVector, lvec)
+IMPLEMENT_VECTOR(float, FloatVector, fvec)
+IMPLEMENT_VECTOR(double, DoubleVector, dvec)
@@ -0,0 +1,23 @@
+#ifndef TYPED_VECTOR_H
+#define TYPED_VECTOR_H
+
+#include "vector_template.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Ready-made instantiations of vector_template.h; the definitions live in
+// typed_vector.c. Instantiate your own element types (including structs)
+// the same way.
+
+DECLARE_VECTOR(long long, LongVector, lvec)
+DECLARE_VECTOR(float, FloatVector, fvec)
+DECLARE_VECTOR(double, DoubleVector, dvec)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TYPED_VECTOR_H
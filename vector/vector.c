@@ -1,161 +1,414 @@
+// syscall(), sysconf() and posix_memalign() for NUMA placement are hidden in
+// strict ISO C modes
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
+// The library always exports the out-of-line checked accessors
+#undef VEC_INLINE_ACCESS
+
 #include "vector.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <time.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <errno.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+// -----------------------------------------------------------------------------
+// BULK COPY (Exact Presizing, memcpy / Streaming Stores)
+// -----------------------------------------------------------------------------
 
-static void vec_grow(Vector *vec, int new_capacity)
+// Copies at least this large bypass the cache with non-temporal stores, so
+// building a huge derived vector does not evict the caller's working set.
+// Roughly the size of a last-level cache.
+#ifndef VEC_STREAM_THRESHOLD_BYTES
+#define VEC_STREAM_THRESHOLD_BYTES (32 * 1024 * 1024)
+#endif
+
+// A vector with room for size elements, and no more unless size is below
+// DEFAULT_CAPACITY (never a zero-byte malloc)
+static Vector vec_alloc_exact(int size)
+{
+    return vec_create_with_capacity(size > 0 ? size : DEFAULT_CAPACITY);
+}
+
+static void bulk_copy(int *dst, const int *src, int count)
 {
-    int *new_data = (int *)realloc(vec->data, vec->capacity * sizeof(int));
-    if (!new_data)
+    if (count <= 0)
+        return;
+
+#if defined(__SSE2__)
+    if ((size_t)count * sizeof(int) >= VEC_STREAM_THRESHOLD_BYTES)
     {
-        fprintf(stderr, "Memory re-allocation failed during resize\n");
-        exit(EXIT_FAILURE);
+        // Streaming stores need a 16-byte aligned destination
+        while (((uintptr_t)dst & 15) != 0 && count > 0)
+        {
+            *dst++ = *src++;
+            count--;
+        }
+
+        for (; count >= 4; count -= 4, dst += 4, src += 4)
+        {
+            _mm_stream_si128((__m128i *)dst, _mm_loadu_si128((const __m128i *)src));
+        }
+
+        while (count-- > 0)
+        {
+            *dst++ = *src++;
+        }
+
+        _mm_sfence();
+        return;
     }
-    vec->data = new_data;
-    vec->capacity = new_capacity;
+#endif
+
+    memcpy(dst, src, (size_t)count * sizeof(int));
+}
+
+static void bulk_zero(int *dst, int count)
+{
+    if (count > 0)
+        memset(dst, 0, (size_t)count * sizeof(int));
+}
+
+static Vector vec_copy_of(const int *src, int count)
+{
+    Vector result = vec_alloc_exact(count);
+    bulk_copy(result.data, src, count);
+    result.size = count;
+    return result;
 }
 
 // -----------------------------------------------------------------------------
 // CORE MANAGEMENT (Creation, Destruction, Properties, Internal Resize)
 // -----------------------------------------------------------------------------
 
-Vector vec_create()
+// The generic core from vector_template.h: mutations drop the cached
+// fingerprint and lookup index, destroy frees the index, and whole-vector
+// copies use bulk_copy's streaming stores. Also defines vec_grow_.
+VECTOR_DEFINITIONS(int, Vector, vec, , , vec_invalidate, vec_disable_lookup_index, bulk_copy)
+VECTOR_QUERY_DEFINITIONS(int, Vector, vec, , )
+
+int vec_capacity(const Vector *vec)
 {
-    return vec_create_with_capacity(DEFAULT_CAPACITY);
+    return vec->capacity;
+}
+
+// -----------------------------------------------------------------------------
+// NUMA PLACEMENT & FIRST TOUCH (Page Placement for Large Vectors)
+// -----------------------------------------------------------------------------
+
+// Linux memory policy modes and flags (linux/mempolicy.h)
+#ifndef MPOL_BIND
+#define MPOL_BIND 2
+#endif
+#ifndef MPOL_INTERLEAVE
+#define MPOL_INTERLEAVE 3
+#endif
+#ifndef MPOL_F_MEMS_ALLOWED
+#define MPOL_F_MEMS_ALLOWED (1 << 2)
+#endif
+
+// Node masks cover the kernel's largest configurable node count
+#define NUMA_MAX_NODES 1024
+#define NUMA_MASK_WORDS (NUMA_MAX_NODES / (8 * sizeof(unsigned long)))
+#define NUMA_WORD_BITS (8 * sizeof(unsigned long))
+
+// Sets the policy for pages of [addr, addr + bytes) that have not been
+// touched yet. Returns false where unsupported so callers fall back to the
+// default first-touch placement.
+static bool numa_apply_policy(void *addr, size_t bytes, VecNumaOptions options)
+{
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_get_mempolicy)
+    unsigned long nodemask[NUMA_MASK_WORDS] = {0};
+    int mode;
+
+    if (options.policy == VEC_NUMA_INTERLEAVE)
+    {
+        // Interleave over the nodes this task may use; an all-ones mask is
+        // rejected by kernels built with fewer nodes than the mask covers
+        int current_mode;
+        if (syscall(SYS_get_mempolicy, &current_mode, nodemask, (unsigned long)NUMA_MAX_NODES, NULL,
+                    MPOL_F_MEMS_ALLOWED) != 0)
+            return false;
+        mode = MPOL_INTERLEAVE;
+    }
+    else
+    {
+        if (options.node < 0 || options.node >= NUMA_MAX_NODES)
+            return false;
+        nodemask[options.node / NUMA_WORD_BITS] = 1UL << (options.node % NUMA_WORD_BITS);
+        mode = MPOL_BIND;
+    }
+
+    // maxnode counts one past the highest node the kernel should read
+    int highest = -1;
+    for (int node = 0; node < NUMA_MAX_NODES; node++)
+        if (nodemask[node / NUMA_WORD_BITS] >> (node % NUMA_WORD_BITS) & 1)
+            highest = node;
+    if (highest < 0)
+        return false;
+
+    return syscall(SYS_mbind, addr, bytes, mode, nodemask, (unsigned long)highest + 2, 0) == 0;
+#else
+    (void)addr;
+    (void)bytes;
+    (void)options;
+    return false;
+#endif
 }
 
-Vector vec_create_with_capacity(int initial_capacity)
+Vector vec_create_numa(int initial_capacity, VecNumaOptions options)
 {
+    if (options.policy == VEC_NUMA_DEFAULT)
+        return vec_create_with_capacity(initial_capacity);
+
+#if defined(__linux__)
+    // The policy applies per page, so the buffer has to start on one
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t bytes = (size_t)(initial_capacity > 0 ? initial_capacity : DEFAULT_CAPACITY) * sizeof(int);
+    bytes = (bytes + page - 1) / page * page;
+
+    // posix_memalign rather than C11 aligned_alloc, which -std=c99 hides
     Vector vec;
-    vec.capacity = initial_capacity;
-    vec.size = 0;
-    vec.data = (int *)malloc(initial_capacity * sizeof(int));
-    if (!vec.data)
+    void *buffer = NULL;
+    if (posix_memalign(&buffer, page, bytes) != 0)
     {
         fprintf(stderr, "Memory allocation failed\n");
         exit(EXIT_FAILURE);
     }
+    vec.data = (int *)buffer;
+    vec.size = 0;
+    vec.capacity = (int)(bytes / sizeof(int));
+    vec.fingerprint = 0;
+    vec.lookup = NULL;
+
+    numa_apply_policy(vec.data, bytes, options);
     return vec;
+#else
+    (void)numa_apply_policy;
+    return vec_create_with_capacity(initial_capacity);
+#endif
 }
 
-void vec_trim_to_size(Vector *vec)
+void vec_fill(Vector *vec, int count, int value)
 {
-    if (!vec || vec->capacity == vec->size)
-        return;
+    vec_invalidate(vec);
+    vec_ensure_capacity(vec, count);
 
-    int *new_data = (int *)realloc(vec->data, vec->size * sizeof(int));
-
-    if (new_data)
+    // Static scheduling matches the split a later "omp parallel for" scan
+    // uses, so each thread faults in the pages it will read itself.
+    int *data = vec->data;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < count; i++)
     {
-        vec->data = new_data;
-        vec->capacity = vec->size;
+        data[i] = value;
     }
+
+    vec->size = count;
 }
 
-void vec_ensure_capacity(Vector *vec, int min_capacity)
+void vec_iota(Vector *vec, int count, int start)
 {
-    if (vec->capacity >= min_capacity)
-        return;
-
-    int new_capacity = vec->capacity > 0 ? vec->capacity : DEFAULT_CAPACITY;
+    vec_invalidate(vec);
+    vec_ensure_capacity(vec, count);
 
-    while (new_capacity < min_capacity)
+    int *data = vec->data;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < count; i++)
     {
-        new_capacity *= GROW_FACTOR;
+        data[i] = start + i;
     }
 
-    int *new_data = (int *)realloc(vec->data, new_capacity * sizeof(int));
+    vec->size = count;
+}
+
+// -----------------------------------------------------------------------------
+// OWNERSHIP TRANSFER (Adopt, Release, Move, Swap)
+// -----------------------------------------------------------------------------
 
-    if (new_data)
+Vector vec_from_buffer_adopt(int *buffer, int size, int capacity)
+{
+    if (size < 0 || capacity < size)
     {
-        vec->data = new_data;
-        vec->capacity = new_capacity;
+        fprintf(stderr, "Invalid buffer (size=%d, capacity=%d)\n", size, capacity);
+        exit(EXIT_FAILURE);
     }
-}
 
-void vec_clear(Vector *vec)
-{
-    vec->size = 0;
+    Vector vec;
+    vec.data = buffer;
+    vec.size = size;
+    vec.capacity = buffer ? capacity : 0;
+    vec.fingerprint = 0;
+    vec.lookup = NULL;
+    return vec;
 }
 
-void vec_destroy(Vector *vec)
+int *vec_release(Vector *vec, int *size, int *capacity)
 {
-    free(vec->data);
-    vec->size = vec->capacity = 0;
+    int *buffer = vec->data;
+
+    if (size)
+        *size = vec->size;
+    if (capacity)
+        *capacity = vec->capacity;
+
+    vec_disable_lookup_index(vec);
     vec->data = NULL;
+    vec->size = vec->capacity = 0;
+    vec->fingerprint = 0;
+    return buffer;
 }
 
-int vec_size(const Vector *vec)
+void vec_move(Vector *dest, Vector *src)
 {
-    return vec->size;
-}
+    if (dest == src)
+        return;
 
-int vec_capacity(const Vector *vec)
-{
-    return vec->capacity;
+    free(dest->data);
+    vec_disable_lookup_index(dest);
+    *dest = *src;
+    src->data = NULL;
+    src->size = src->capacity = 0;
+    src->fingerprint = 0;
+    src->lookup = NULL;
 }
 
-bool vec_is_empty(const Vector *vec)
+void vec_swap_contents(Vector *vec1, Vector *vec2)
 {
-    return vec->size == 0;
+    Vector temp = *vec1;
+    *vec1 = *vec2;
+    *vec2 = temp;
 }
 
 // -----------------------------------------------------------------------------
-// ELEMENT MODIFICATION (Add, Insert, Remove, Set)
+// DIRECT TAIL WRITES (Reserve, Commit, Read From File Descriptors)
 // -----------------------------------------------------------------------------
 
-void vec_add(Vector *vec, int element)
-{
-    if (vec->size == vec->capacity)
-        vec_grow(vec, vec->capacity * GROW_FACTOR);
-
-    vec->data[vec->size++] = element;
-}
+// Elements requested from the kernel per read() in vec_read_fd
+#ifndef VEC_READ_CHUNK
+#define VEC_READ_CHUNK 4096
+#endif
 
-void vec_add_all(Vector *vec, Vector *other)
+int *vec_reserve_back(Vector *vec, int n)
 {
-    int required = vec->size + other->size;
-    if (required > vec->capacity)
+    if (n < 0)
+    {
+        fprintf(stderr, "%d is negative\n", n);
+        exit(EXIT_FAILURE);
+    }
+
+    if (vec->size + n > vec->capacity)
     {
-        int new_capacity = vec->capacity;
-        while (new_capacity < required)
+        vec_ensure_capacity(vec, vec->size + n);
+        if (vec->size + n > vec->capacity)
         {
-            new_capacity *= GROW_FACTOR;
+            fprintf(stderr, "Memory re-allocation failed during resize\n");
+            exit(EXIT_FAILURE);
         }
     }
 
-    memcpy(&vec->data[vec->size], other->data, other->size * sizeof(int));
-    vec->size += other->size;
+    return vec->data + vec->size;
 }
 
-void vec_insert(Vector *vec, int index, int element)
+void vec_commit_back(Vector *vec, int written)
 {
-    if (index < 0 || index > vec->size)
+    vec_invalidate(vec);
+    if (written < 0 || vec->size + written > vec->capacity)
     {
-        fprintf(stderr, "Index out of bounds in vec_insert (index=%d, size=%d)\n", index, vec->size);
-        return;
+        fprintf(stderr, "Invalid commit in vec_commit_back (written=%d, size=%d, capacity=%d)\n",
+                written, vec->size, vec->capacity);
+        exit(EXIT_FAILURE);
     }
 
-    if (vec->size >= vec->capacity)
-    {
-        vec_grow(vec, vec->capacity * GROW_FACTOR);
-    }
+    vec->size += written;
+}
 
-    for (int i = vec->size; i > index; i--)
+int vec_read_fd(Vector *vec, int fd, int max_elements)
+{
+#if defined(__unix__) || defined(__APPLE__)
+    int appended = 0;
+
+    for (;;)
     {
-        vec->data[i] = vec->data[i - 1];
-    }
+        int want = VEC_READ_CHUNK;
+        if (max_elements > 0 && max_elements - appended < want)
+            want = max_elements - appended;
+        if (want == 0)
+            return appended;
 
-    vec->data[index] = element;
-    vec->size++;
+        char *dst = (char *)vec_reserve_back(vec, want);
+        size_t wanted_bytes = (size_t)want * sizeof(int);
+        size_t bytes = 0;
+
+        // Fill the reserved slots straight from the kernel; read() may return
+        // fewer bytes than asked, even mid-element, so keep going to EOF
+        while (bytes < wanted_bytes)
+        {
+            ssize_t n = read(fd, dst + bytes, wanted_bytes - bytes);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n < 0)
+            {
+                vec_commit_back(vec, (int)(bytes / sizeof(int)));
+                return -1;
+            }
+            if (n == 0)
+                break;
+            bytes += (size_t)n;
+        }
+
+        vec_commit_back(vec, (int)(bytes / sizeof(int)));
+        appended += (int)(bytes / sizeof(int));
+
+        if (bytes < wanted_bytes)
+        {
+            // EOF; a trailing partial element means the input was truncated
+            if (bytes % sizeof(int) != 0)
+            {
+                errno = EIO;
+                return -1;
+            }
+            return appended;
+        }
+    }
+#else
+    (void)vec;
+    (void)fd;
+    (void)max_elements;
+    return -1;
+#endif
 }
 
+// -----------------------------------------------------------------------------
+// ELEMENT MODIFICATION (Add, Insert, Remove, Set)
+// -----------------------------------------------------------------------------
+
 void vec_insert_sorted(Vector *vec, int element)
 {
+    vec_invalidate(vec);
     if (vec->size >= vec->capacity)
     {
-        vec_grow(vec, vec->capacity * GROW_FACTOR);
+        vec_grow_(vec, vec->capacity * GROW_FACTOR);
     }
 
     if (!vec_is_sorted(vec))
@@ -175,86 +428,204 @@ void vec_insert_sorted(Vector *vec, int element)
     vec->size++;
 }
 
-int vec_remove(Vector *vec, int index)
+void vec_add_first(Vector *vec, int element)
 {
-    if (index < 0 || index >= vec->size)
-    {
-        fprintf(stderr, "Index out of bounds in vec_remove (index=%d, size=%d)\n", index, vec->size);
-    }
+    vec_insert(vec, 0, element);
+}
 
-    int element = vec->data[index];
+void vec_add_last(Vector *vec, int element)
+{
+    vec_add(vec, element);
+}
 
-    for (int i = index; i < vec->size - 1; i++)
-    {
-        vec->data[i] = vec->data[i + 1];
-    }
+int vec_remove_first(Vector *vec)
+{
+    return vec_remove(vec, 0);
+}
 
-    vec->size--;
+// -----------------------------------------------------------------------------
+// ADAPTIVE LOOKUP INDEX (Bloom Filter + Position Hash, Built on Demand)
+// -----------------------------------------------------------------------------
+
+// Lookups on an unchanged vector before the index is built, and the smallest
+// vector worth indexing; below either a linear scan is cheaper
+#ifndef VEC_LOOKUP_THRESHOLD
+#define VEC_LOOKUP_THRESHOLD 8
+#endif
+
+#ifndef VEC_LOOKUP_MIN_SIZE
+#define VEC_LOOKUP_MIN_SIZE 64
+#endif
+
+typedef struct
+{
+    int key;
+    int first; // Lowest position holding key
+    int last;  // Highest position holding key
+    int count; // Occurrences of key; 0 marks an empty slot
+} VecLookupEntry;
+
+struct VecLookup
+{
+    int queries;             // Lookups since the vector last changed
+    bool built;              // Index matches the current elements
+    VecLookupEntry *entries; // Open-addressing table, linear probing
+    size_t slot_mask;        // Slot count - 1 (a power of two)
+    uint64_t *bloom;         // Two bits per distinct key
+    uint64_t bloom_mask;     // Bloom bit count - 1 (a power of two)
+    int bloom_shift;         // 64 - log2(bloom bit count)
+};
 
-    return element;
+static uint64_t lookup_hash(int key)
+{
+    return ((uint64_t)(uint32_t)key + 1) * 0x9E3779B97F4A7C15ull;
 }
 
-void vec_remove_if(Vector *vec, Predicate predicate)
+// The two filter probes come from opposite ends of the hash, so they stay
+// independent of each other and of the slot index taken from the middle.
+static void lookup_bloom_bits(const VecLookup *lookup, uint64_t h, uint64_t *bit1, uint64_t *bit2)
 {
-    int write = 0;
+    *bit1 = h & lookup->bloom_mask;
+    *bit2 = h >> lookup->bloom_shift;
+}
 
-    for (int read = 0; read < vec->size; read++)
+static void *lookup_realloc(void *memory, size_t size)
+{
+    memory = realloc(memory, size);
+    if (!memory)
     {
-        if (!predicate(vec->data[read]))
-            vec->data[write++] = vec->data[read];
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
     }
-
-    vec->size = write;
+    return memory;
 }
 
-int vec_set(Vector *vec, int index, int element)
+// One pass in index order, so first and last fall out of insertion order.
+// The table is at most half full and the filter has 8 bits per element.
+static void lookup_build(VecLookup *lookup, const Vector *vec)
 {
-    if (index < 0 || index >= vec->size)
+    // size_t so that 2 * size cannot overflow for vectors past 2^30 elements
+    size_t slots = 64;
+    int slot_bits = 6;
+    while (slots < 2 * (size_t)vec->size)
     {
-        fprintf(stderr, "Index %d is out of range [0..%d]", index, vec->size);
-        exit(EXIT_FAILURE);
+        slots <<= 1;
+        slot_bits++;
+    }
+
+    if (slots - 1 != lookup->slot_mask || !lookup->entries)
+    {
+        lookup->entries = (VecLookupEntry *)lookup_realloc(lookup->entries, slots * sizeof(VecLookupEntry));
+        lookup->bloom = (uint64_t *)lookup_realloc(lookup->bloom, slots / 16 * sizeof(uint64_t));
+        lookup->slot_mask = slots - 1;
+        lookup->bloom_mask = (uint64_t)slots * 4 - 1;
+        lookup->bloom_shift = 64 - (slot_bits + 2);
     }
 
-    int previous_element = vec->data[index];
-    vec->data[index] = element;
+    memset(lookup->entries, 0, slots * sizeof(VecLookupEntry));
+    memset(lookup->bloom, 0, slots / 16 * sizeof(uint64_t));
+
+    for (int i = 0; i < vec->size; i++)
+    {
+        int key = vec->data[i];
+        uint64_t h = lookup_hash(key);
+        size_t slot = (size_t)(h >> 32) & lookup->slot_mask;
+
+        while (lookup->entries[slot].count != 0 && lookup->entries[slot].key != key)
+            slot = (slot + 1) & lookup->slot_mask;
 
-    return previous_element;
+        VecLookupEntry *entry = &lookup->entries[slot];
+        if (entry->count == 0)
+        {
+            uint64_t bit1, bit2;
+            lookup_bloom_bits(lookup, h, &bit1, &bit2);
+            lookup->bloom[bit1 >> 6] |= 1ull << (bit1 & 63);
+            lookup->bloom[bit2 >> 6] |= 1ull << (bit2 & 63);
+
+            entry->key = key;
+            entry->first = i;
+        }
+        entry->last = i;
+        entry->count++;
+    }
+
+    lookup->built = true;
 }
 
-void vec_add_first(Vector *vec, int element)
+// Returns false when the caller should scan instead. Otherwise *entry is the
+// key's entry, or NULL if the key does not occur.
+static bool lookup_find(const Vector *vec, int key, const VecLookupEntry **entry)
 {
-    vec_insert(vec, 0, element);
+    VecLookup *lookup = vec->lookup;
+
+    if (!lookup || vec->size < VEC_LOOKUP_MIN_SIZE)
+        return false;
+
+    if (!lookup->built)
+    {
+        if (++lookup->queries < VEC_LOOKUP_THRESHOLD)
+            return false;
+        lookup_build(lookup, vec);
+    }
+
+    uint64_t h = lookup_hash(key);
+    uint64_t bit1, bit2;
+    lookup_bloom_bits(lookup, h, &bit1, &bit2);
+
+    *entry = NULL;
+
+    // Most misses stop here without touching the larger table
+    if (!(lookup->bloom[bit1 >> 6] >> (bit1 & 63) & 1) || !(lookup->bloom[bit2 >> 6] >> (bit2 & 63) & 1))
+        return true;
+
+    for (size_t slot = (size_t)(h >> 32) & lookup->slot_mask; lookup->entries[slot].count != 0;
+         slot = (slot + 1) & lookup->slot_mask)
+    {
+        if (lookup->entries[slot].key == key)
+        {
+            *entry = &lookup->entries[slot];
+            break;
+        }
+    }
+
+    return true;
 }
 
-void vec_add_last(Vector *vec, int element)
+void vec_enable_lookup_index(Vector *vec)
 {
-    vec_add(vec, element);
+    if (vec->lookup)
+        return;
+
+    vec->lookup = (VecLookup *)calloc(1, sizeof(VecLookup));
+    if (!vec->lookup)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
 }
 
-int vec_remove_first(Vector *vec)
+void vec_disable_lookup_index(Vector *vec)
 {
-    return vec_remove(vec, 0);
+    if (!vec->lookup)
+        return;
+
+    free(vec->lookup->entries);
+    free(vec->lookup->bloom);
+    free(vec->lookup);
+    vec->lookup = NULL;
 }
 
-int vec_remove_last(Vector *vec)
+void vec_lookup_reset(Vector *vec)
 {
-    return vec_remove(vec, vec->size - 1);
+    // Keeps the buffers for the next build
+    vec->lookup->built = false;
+    vec->lookup->queries = 0;
 }
 
 // -----------------------------------------------------------------------------
 // ELEMENT ACCESS & INFORMATION (Get, Search, Indexing)
 // -----------------------------------------------------------------------------
 
-int vec_get(const Vector *vec, int index)
-{
-    if (index < 0 || index >= vec->size)
-    {
-        fprintf(stderr, "Index %d is out of range [0..%d]", index, vec->size);
-        exit(EXIT_FAILURE);
-    }
-    return vec->data[index];
-}
-
 int vec_get_first(const Vector *vec)
 {
     return vec->data[0];
@@ -267,6 +638,10 @@ int vec_get_last(const Vector *vec)
 
 bool vec_contains(const Vector *vec, int element)
 {
+    const VecLookupEntry *entry;
+    if (lookup_find(vec, element, &entry))
+        return entry != NULL;
+
     for (int i = 0; i < vec->size; i++)
     {
         if (vec->data[i] == element)
@@ -291,6 +666,10 @@ bool vec_contains_all(const Vector *vec, const Vector *other)
 
 int vec_indexof(const Vector *vec, int element)
 {
+    const VecLookupEntry *entry;
+    if (lookup_find(vec, element, &entry))
+        return entry ? entry->first : -1;
+
     return vec_indexof_range(vec, element, 0, vec->size - 1);
 }
 
@@ -327,6 +706,10 @@ int vec_indexof_range(const Vector *vec, int element, int start, int end)
 
 int vec_last_indexof(const Vector *vec, int element)
 {
+    const VecLookupEntry *entry;
+    if (lookup_find(vec, element, &entry))
+        return entry ? entry->last : -1;
+
     return vec_last_indexof_range(vec, element, 0, vec->size - 1);
 }
 
@@ -401,39 +784,6 @@ bool vec_is_sorted(const Vector *vec)
 // TRANSFORMATION & DERIVATION (New Vectors or In-Place Structure Change)
 // -----------------------------------------------------------------------------
 
-Vector vec_map(const Vector *vec, Function mapper)
-{
-    Vector result = vec_create_with_capacity(vec->size);
-
-    for (int i = 0; i < vec->size; i++)
-    {
-        vec_add(&result, mapper(vec->data[i]));
-    }
-
-    return result;
-}
-
-void vec_replace_all(Vector *vec, Function mapper)
-{
-    for (int i = 0; i < vec->size; i++)
-    {
-        vec->data[i] = mapper(vec->data[i]);
-    }
-}
-
-Vector vec_filter(const Vector *vec, Predicate predicate)
-{
-    Vector result = vec_create_with_capacity(vec->capacity);
-
-    for (int i = 0; i < vec->size; i++)
-    {
-        if (predicate(vec->data[i]))
-            vec_add(&result, vec->data[i]);
-    }
-
-    return result;
-}
-
 Vector vec_subvec(const Vector *vec, int from_index, int to_index)
 {
     if (from_index < 0 || to_index > vec->size)
@@ -448,22 +798,7 @@ Vector vec_subvec(const Vector *vec, int from_index, int to_index)
         exit(EXIT_FAILURE);
     }
 
-    Vector subvec;
-    subvec.capacity = subvec.size = to_index - from_index;
-    subvec.data = (int *)malloc(subvec.size * sizeof(int));
-
-    if (!subvec.data)
-    {
-        fprintf(stderr, "Memory allocation failed\n");
-        exit(EXIT_FAILURE);
-    }
-
-    for (int i = 0; i < subvec.size; i++)
-    {
-        subvec.data[i] = vec->data[from_index + i];
-    }
-
-    return subvec;
+    return vec_copy_of(vec->data + from_index, to_index - from_index);
 }
 
 Vector vec_limit(const Vector *vec, int max_size)
@@ -474,14 +809,7 @@ Vector vec_limit(const Vector *vec, int max_size)
         exit(EXIT_FAILURE);
     }
 
-    Vector result = vec_create_with_capacity(max_size);
-
-    for (int i = 0; i < max_size; i++)
-    {
-        vec_add(&result, vec->data[i]);
-    }
-
-    return result;
+    return vec_copy_of(vec->data, max_size < vec->size ? max_size : vec->size);
 }
 
 Vector vec_skip(const Vector *vec, int n)
@@ -497,35 +825,23 @@ Vector vec_skip(const Vector *vec, int n)
         return vec_create();
     }
 
-    int result_size = vec->size - n;
-    Vector result = vec_create_with_capacity(result_size);
-
-    for (int i = 0; i < result_size; i++)
-    {
-        vec_add(&result, vec->data[n + i]);
-    }
-
-    return result;
+    return vec_copy_of(vec->data + n, vec->size - n);
 }
 
 Vector vec_concat(const Vector *v1, const Vector *v2)
 {
-    Vector result = vec_create_with_capacity(v1->size + v2->size);
+    Vector result = vec_alloc_exact(v1->size + v2->size);
 
-    for (int i = 0; i < v1->size; i++)
-    {
-        vec_add(&result, v1->data[i]);
-    }
-    for (int i = 0; i < v2->size; i++)
-    {
-        vec_add(&result, v2->data[i]);
-    }
+    bulk_copy(result.data, v1->data, v1->size);
+    bulk_copy(result.data + v1->size, v2->data, v2->size);
+    result.size = v1->size + v2->size;
 
     return result;
 }
 
 void vec_reverse(Vector *vec)
 {
+    vec_invalidate(vec);
     for (int i = 0; i < vec->size / 2; i++)
     {
         int temp = vec->data[i];
@@ -534,100 +850,64 @@ void vec_reverse(Vector *vec)
     }
 }
 
-Vector vec_shift_left(const Vector *vec, int positions)
+// Lays out zero_head zeros, head_count elements starting at from_index, the
+// first tail_count elements and zero_tail zeros: every shift and rotation is
+// two bulk copies plus zero fill into one exactly sized vector.
+static Vector vec_assemble(const Vector *vec, int zero_head, int from_index, int head_count, int tail_count, int zero_tail)
 {
-    positions = positions % vec->size;
-
-    if (positions == 0)
-    {
-        return *vec;
-    }
+    Vector result = vec_alloc_exact(vec->size);
+    int *out = result.data;
 
-    Vector shifted = vec_create_with_capacity(vec->size);
+    bulk_zero(out, zero_head);
+    out += zero_head;
+    bulk_copy(out, vec->data + from_index, head_count);
+    out += head_count;
+    bulk_copy(out, vec->data, tail_count);
+    out += tail_count;
+    bulk_zero(out, zero_tail);
 
-    for (int i = positions; i < vec->size; i++)
-    {
-        vec_add(&shifted, vec->data[i]);
-    }
+    result.size = vec->size;
+    return result;
+}
 
-    for (int i = 0; i < positions; i++)
-    {
-        vec_add(&shifted, 0);
-    }
+Vector vec_shift_left(const Vector *vec, int positions)
+{
+    if (vec->size == 0)
+        return vec_create();
 
-    return shifted;
+    positions = positions % vec->size;
+
+    return vec_assemble(vec, 0, positions, vec->size - positions, 0, positions);
 }
 
 Vector vec_shift_right(const Vector *vec, int positions)
 {
-    positions = positions % vec->size;
-
-    if (positions == 0)
-    {
-        return *vec;
-    }
-
-    Vector shifted = vec_create_with_capacity(vec->size);
-
-    for (int i = 0; i < positions; i++)
-    {
-        vec_add(&shifted, 0);
-    }
+    if (vec->size == 0)
+        return vec_create();
 
-    for (int i = 0; i < vec->size - positions; i++)
-    {
-        vec_add(&shifted, vec->data[i]);
-    }
+    positions = positions % vec->size;
 
-    return shifted;
+    return vec_assemble(vec, positions, 0, 0, vec->size - positions, 0);
 }
 
 Vector vec_rotate_left(const Vector *vec, int positions)
 {
-    positions = positions % vec->size;
-
-    if (positions == 0)
-    {
-        return *vec;
-    }
-
-    Vector shifted = vec_create_with_capacity(vec->size);
-
-    for (int i = positions; i < vec->size; i++)
-    {
-        vec_add(&shifted, vec->data[i]);
-    }
+    if (vec->size == 0)
+        return vec_create();
 
-    for (int i = 0; i < positions; i++)
-    {
-        vec_add(&shifted, vec->data[i]);
-    }
+    positions = positions % vec->size;
 
-    return shifted;
+    return vec_assemble(vec, 0, positions, vec->size - positions, positions, 0);
 }
 
 Vector vec_rotate_right(const Vector *vec, int positions)
 {
-    positions = positions % vec->size;
-
-    if (positions == 0)
-    {
-        return *vec;
-    }
-
-    Vector shifted = vec_create_with_capacity(vec->size);
-
-    for (int i = 0; i < positions; i++)
-    {
-        vec_add(&shifted, vec->data[vec->size - positions + i]);
-    }
+    if (vec->size == 0)
+        return vec_create();
 
-    for (int i = 0; i < vec->size - positions; i++)
-    {
-        vec_add(&shifted, vec->data[i]);
-    }
+    positions = positions % vec->size;
 
-    return shifted;
+    return vec_assemble(vec, 0, vec->size - positions, positions, vec->size - positions, 0);
 }
 
 int *vec_to_array(const Vector *vec)
@@ -646,6 +926,7 @@ int *vec_to_array(const Vector *vec)
 
 void vec_rearrange(Vector *vec)
 {
+    vec_invalidate(vec);
     int i = 0;             // point to positive numbers
     int j = vec->size - 1; // point to negative numbers
 
@@ -668,40 +949,213 @@ void vec_rearrange(Vector *vec)
     }
 }
 
-Vector vec_merge(const Vector *vec1, const Vector *vec2)
+// Output elements per partition in vec_merge_parallel
+#ifndef MERGE_PARALLEL_CHUNK
+#define MERGE_PARALLEL_CHUNK (1 << 16)
+#endif
+
+// Merges two sorted runs into out. Ties take from a first, so the merge is
+// stable with respect to the argument order.
+static void merge_runs(const int *a, int n1, const int *b, int n2, int *out)
+{
+    int i = 0;
+    int j = 0;
+    int k = 0;
+
+    while (i < n1 && j < n2)
+    {
+        out[k++] = b[j] < a[i] ? b[j++] : a[i++];
+    }
+
+    memcpy(out + k, a + i, (n1 - i) * sizeof(int));
+    memcpy(out + k + (n1 - i), b + j, (n2 - j) * sizeof(int));
+}
+
+// Merge path: how many of the first diag merged elements come from a
+static int merge_path_split(const int *a, int n1, const int *b, int n2, int diag)
+{
+    int lo = diag > n2 ? diag - n2 : 0;
+    int hi = diag < n1 ? diag : n1;
+
+    while (lo < hi)
+    {
+        int i = lo + (hi - lo) / 2;
+        if (a[i] <= b[diag - i - 1])
+            lo = i + 1;
+        else
+            hi = i;
+    }
+
+    return lo;
+}
+
+static void check_sorted(const Vector *vec)
 {
-    if (!vec_is_sorted(vec1) || !vec_is_sorted(vec2))
+    if (!vec_is_sorted(vec))
     {
         fprintf(stderr, "The vectors are not sorted\n");
         exit(EXIT_FAILURE);
     }
+}
+
+Vector vec_merge(const Vector *vec1, const Vector *vec2)
+{
+    check_sorted(vec1);
+    check_sorted(vec2);
+
+    return vec_merge_unchecked(vec1, vec2);
+}
 
+Vector vec_merge_unchecked(const Vector *vec1, const Vector *vec2)
+{
     int size = vec1->size + vec2->size;
-    Vector result = vec_create_with_capacity(size);
+    Vector result = vec_create_with_capacity(size > 0 ? size : DEFAULT_CAPACITY);
 
-    int i = 0;
-    int j = 0;
+    merge_runs(vec1->data, vec1->size, vec2->data, vec2->size, result.data);
+    result.size = size;
+
+    return result;
+}
+
+Vector vec_merge_parallel(const Vector *vec1, const Vector *vec2)
+{
+    check_sorted(vec1);
+    check_sorted(vec2);
+
+    int size = vec1->size + vec2->size;
+    int partitions = (size + MERGE_PARALLEL_CHUNK - 1) / MERGE_PARALLEL_CHUNK;
+    Vector result = vec_create_with_capacity(size > 0 ? size : DEFAULT_CAPACITY);
 
-    while (i < vec1->size && j < vec2->size)
+    // Every partition finds its own start on the merge path by binary search,
+    // so the partitions share nothing and can be merged concurrently.
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int p = 0; p < partitions; p++)
     {
-        if (vec1->data[i] < vec2->data[j])
-        {
-            vec_add(&result, vec1->data[i++]);
-        }
-        else
-        {
-            vec_add(&result, vec2->data[j++]);
-        }
+        int begin = p * MERGE_PARALLEL_CHUNK;
+        int end = begin + MERGE_PARALLEL_CHUNK < size ? begin + MERGE_PARALLEL_CHUNK : size;
+        int i_begin = merge_path_split(vec1->data, vec1->size, vec2->data, vec2->size, begin);
+        int i_end = merge_path_split(vec1->data, vec1->size, vec2->data, vec2->size, end);
+
+        merge_runs(vec1->data + i_begin, i_end - i_begin,
+                   vec2->data + (begin - i_begin), (end - i_end) - (begin - i_begin),
+                   result.data + begin);
+    }
+
+    result.size = size;
+    return result;
+}
+
+typedef struct
+{
+    const int *data;
+    int pos;
+    int size;
+} MergeSource;
+
+// Source a wins against b if its head is smaller; exhausted sources always
+// lose and ties go to the lower source index, keeping the merge stable.
+static bool merge_source_beats(const MergeSource *sources, int a, int b)
+{
+    bool a_done = sources[a].pos == sources[a].size;
+    bool b_done = sources[b].pos == sources[b].size;
+
+    if (a_done || b_done)
+        return !a_done && b_done;
+
+    int x = sources[a].data[sources[a].pos];
+    int y = sources[b].data[sources[b].pos];
+    return x < y || (x == y && a < b);
+}
+
+// Builds the subtree rooted at node, storing the loser of every match in
+// tree[node] and returning the winner. Leaves are nodes k..2k-1.
+static int loser_tree_build(int *tree, const MergeSource *sources, int node, int k)
+{
+    if (node >= k)
+        return node - k;
+
+    int left = loser_tree_build(tree, sources, 2 * node, k);
+    int right = loser_tree_build(tree, sources, 2 * node + 1, k);
+
+    if (merge_source_beats(sources, left, right))
+    {
+        tree[node] = right;
+        return left;
+    }
+
+    tree[node] = left;
+    return right;
+}
+
+Vector vec_merge_k(const Vector *vecs, int count)
+{
+    for (int s = 0; s < count; s++)
+    {
+        check_sorted(&vecs[s]);
+    }
+
+    return vec_merge_k_unchecked(vecs, count);
+}
+
+Vector vec_merge_k_unchecked(const Vector *vecs, int count)
+{
+    if (count < 0)
+    {
+        fprintf(stderr, "%d is negative\n", count);
+        exit(EXIT_FAILURE);
+    }
+
+    if (count == 0)
+        return vec_create();
+
+    int size = 0;
+    for (int s = 0; s < count; s++)
+    {
+        size += vecs[s].size;
+    }
+
+    Vector result = vec_create_with_capacity(size > 0 ? size : DEFAULT_CAPACITY);
+    MergeSource *sources = (MergeSource *)malloc(count * sizeof(MergeSource));
+    int *tree = (int *)malloc(count * sizeof(int));
+    if (!sources || !tree)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
     }
-    for (; i < vec1->size; i++)
+
+    for (int s = 0; s < count; s++)
     {
-        vec_add(&result, vec1->data[i++]);
+        sources[s].data = vecs[s].data;
+        sources[s].pos = 0;
+        sources[s].size = vecs[s].size;
     }
-    for (; j < vec2->size; j++)
+
+    // Tournament (loser) tree: after taking the winner's head, only the
+    // matches on its leaf-to-root path are replayed, log2(k) comparisons.
+    int winner = loser_tree_build(tree, sources, 1, count);
+
+    for (int k = 0; k < size; k++)
     {
-        vec_add(&result, vec2->data[j++]);
+        MergeSource *source = &sources[winner];
+        result.data[k] = source->data[source->pos++];
+
+        for (int node = (count + winner) / 2; node >= 1; node /= 2)
+        {
+            if (merge_source_beats(sources, tree[node], winner))
+            {
+                int loser = winner;
+                winner = tree[node];
+                tree[node] = loser;
+            }
+        }
     }
 
+    result.size = size;
+
+    free(tree);
+    free(sources);
     return result;
 }
 
@@ -822,6 +1276,10 @@ int vec_product(const Vector *vec)
 
 int vec_count(const Vector *vec, int element)
 {
+    const VecLookupEntry *entry;
+    if (lookup_find(vec, element, &entry))
+        return entry ? entry->count : 0;
+
     int count = 0;
 
     for (int i = 0; i < vec->size; i++)
@@ -834,137 +1292,1567 @@ int vec_count(const Vector *vec, int element)
 }
 
 // -----------------------------------------------------------------------------
-// PREDICATE-BASED LOGIC (Checks all/any/none elements)
+// SELECTION & ORDER STATISTICS (Nth Element, Median, Quantiles, Top-K)
 // -----------------------------------------------------------------------------
 
-bool vec_all(const Vector *vec, Predicate predicate)
+#define SELECT_INSERTION_THRESHOLD 16
+
+static void swap_ints(int *a, int *b)
 {
-    for (int i = 0; i < vec->size; i++)
-    {
-        if (!predicate(vec->data[i]))
-            return false;
-    }
-    return true;
+    int temp = *a;
+    *a = *b;
+    *b = temp;
 }
 
-bool vec_any(const Vector *vec, Predicate predicate)
+static int compare_ints(const void *a, const void *b)
 {
-    for (int i = 0; i < vec->size; i++)
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static int *copy_elements(const Vector *vec)
+{
+    int *copy = (int *)malloc((vec->size > 0 ? vec->size : 1) * sizeof(int));
+    if (!copy)
     {
-        if (predicate(vec->data[i]))
-            return true;
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
     }
-    return true;
+    memcpy(copy, vec->data, vec->size * sizeof(int));
+    return copy;
 }
 
-bool vec_none(const Vector *vec, Predicate predicate)
+static void insertion_sort_range(int *data, int lo, int hi)
 {
-    for (int i = 0; i < vec->size; i++)
+    for (int i = lo + 1; i <= hi; i++)
     {
-        if (predicate(vec->data[i]))
-            return false;
+        int key = data[i];
+        int j = i - 1;
+        while (j >= lo && data[j] > key)
+        {
+            data[j + 1] = data[j];
+            j--;
+        }
+        data[j + 1] = key;
     }
-    return true;
 }
 
-int vec_find_first(const Vector *vec, Predicate predicate)
+// Sifts heap[i] down a binary heap of the given size. With max_heap the
+// largest value sits at the root, otherwise the smallest one does.
+static void heap_sift_down(int *heap, int size, int i, bool max_heap)
 {
-    for (int i = 0; i < vec->size; i++)
+    int value = heap[i];
+
+    for (;;)
     {
-        if (predicate(vec->data[i]))
-            return vec->data[i];
+        int child = 2 * i + 1;
+        if (child >= size)
+            break;
+
+        if (child + 1 < size && (max_heap ? heap[child + 1] > heap[child] : heap[child + 1] < heap[child]))
+            child++;
+
+        if (max_heap ? heap[child] <= value : heap[child] >= value)
+            break;
+
+        heap[i] = heap[child];
+        i = child;
     }
-    return -1;
+
+    heap[i] = value;
 }
 
-int vec_find_last(const Vector *vec, Predicate predicate)
+static void heap_build(int *heap, int size, bool max_heap)
 {
-    for (int i = vec->size - 1; i >= 0; i--)
+    for (int i = size / 2 - 1; i >= 0; i--)
     {
-        if (predicate(vec->data[i]))
-            return vec->data[i];
+        heap_sift_down(heap, size, i, max_heap);
     }
-    return -1;
 }
 
-// -----------------------------------------------------------------------------
-// HIGHER-ORDER UTILITIES (Generic application of functions)
-// -----------------------------------------------------------------------------
-
-void vec_foreach(const Vector *vec, Consumer action)
+// Fallback used by select_range once quickselect stops converging: keeps the
+// (n - lo + 1) smallest values of [lo, hi] in a max-heap, which is O(n log k)
+// in the worst case instead of quickselect's O(n^2).
+static void heap_select(int *data, int lo, int hi, int n)
 {
-    for (int i = 0; i < vec->size; i++)
+    int *heap = data + lo;
+    int heap_size = n - lo + 1;
+
+    heap_build(heap, heap_size, true);
+
+    for (int i = n + 1; i <= hi; i++)
     {
-        action(vec->data[i]);
+        if (data[i] < heap[0])
+        {
+            swap_ints(&data[i], &heap[0]);
+            heap_sift_down(heap, heap_size, 0, true);
+        }
     }
+
+    swap_ints(&heap[0], &data[n]);
 }
 
-// -----------------------------------------------------------------------------
-// UTILITY & DEBUGGING (Miscellaneous Helpers)
-// -----------------------------------------------------------------------------
+static int median_of_three(const int *data, int lo, int hi)
+{
+    int mid = lo + (hi - lo) / 2;
+    int a = data[lo], b = data[mid], c = data[hi];
 
-char *vec_to_string(const Vector *vec)
+    if (a < b)
+        return b < c ? mid : (a < c ? hi : lo);
+    return a < c ? lo : (b < c ? hi : mid);
+}
+
+static int floor_log2(int n)
 {
-    if (vec == NULL || vec->size == 0)
+    int log = 0;
+    while (n >>= 1)
+        log++;
+    return log;
+}
+
+// Introselect: quickselect with a median-of-three pivot and a three-way
+// partition (so runs of duplicates cost nothing), falling back to heap
+// selection after 2*log2(n) rounds. Afterwards data[n] holds the value that
+// would be there if [lo, hi] were sorted, with smaller values before it and
+// larger values after it.
+static void select_range(int *data, int lo, int hi, int n)
+{
+    int depth_limit = 2 * floor_log2(hi - lo + 1);
+
+    while (hi - lo >= SELECT_INSERTION_THRESHOLD)
     {
-        char *empty = malloc(3);
-        if (empty)
-            strcpy(empty, "[]");
-        return empty;
+        if (depth_limit-- == 0)
+        {
+            heap_select(data, lo, hi, n);
+            return;
+        }
+
+        int pivot = data[median_of_three(data, lo, hi)];
+        int lt = lo;
+        int gt = hi;
+        int i = lo;
+
+        while (i <= gt)
+        {
+            if (data[i] < pivot)
+                swap_ints(&data[lt++], &data[i++]);
+            else if (data[i] > pivot)
+                swap_ints(&data[i], &data[gt--]);
+            else
+                i++;
+        }
+
+        if (n < lt)
+            hi = lt - 1;
+        else if (n > gt)
+            lo = gt + 1;
+        else
+            return;
     }
 
-    int est_len = vec->size * 14 + 3; // generous estimate
-    char *buffer = malloc(est_len);
-    if (!buffer)
-        return NULL;
+    insertion_sort_range(data, lo, hi);
+}
 
-    int offset = 0;
-    offset += snprintf(buffer + offset, est_len - offset, "[");
+// Places every rank of ranks[rlo..rhi] (sorted, distinct, inside [lo, hi])
+// at its final position, reusing each partition for the ranks on either side.
+static void multi_select(int *data, int lo, int hi, const int *ranks, int rlo, int rhi)
+{
+    if (rlo > rhi || lo >= hi)
+        return;
 
-    for (int i = 0; i < vec->size; ++i)
+    int mid = rlo + (rhi - rlo) / 2;
+    int rank = ranks[mid];
+
+    select_range(data, lo, hi, rank);
+    multi_select(data, lo, rank - 1, ranks, rlo, mid - 1);
+    multi_select(data, rank + 1, hi, ranks, mid + 1, rhi);
+}
+
+int vec_nth_element(Vector *vec, int n)
+{
+    vec_invalidate(vec);
+    if (n < 0 || n >= vec->size)
     {
-        offset += snprintf(buffer + offset, est_len - offset, "%d", vec->data[i]);
-        if (i < vec->size - 1)
-            offset += snprintf(buffer + offset, est_len - offset, ", ");
+        fprintf(stderr, "Index out of bounds in vec_nth_element (n=%d, size=%d)\n", n, vec->size);
+        exit(EXIT_FAILURE);
     }
 
-    snprintf(buffer + offset, est_len - offset, "]");
-    return buffer;
+    select_range(vec->data, 0, vec->size - 1, n);
+    return vec->data[n];
 }
 
-void vec_printf(const Vector *vec)
+void vec_partial_sort(Vector *vec, int k)
 {
-    char *str = vec_to_string(vec);
-    if (str)
+    vec_invalidate(vec);
+    if (k < 0 || k > vec->size)
     {
-        puts(str);
-        free(str);
+        fprintf(stderr, "Index out of bounds in vec_partial_sort (k=%d, size=%d)\n", k, vec->size);
+        exit(EXIT_FAILURE);
     }
+
+    if (k == 0)
+        return;
+
+    if (k < vec->size)
+        select_range(vec->data, 0, vec->size - 1, k - 1);
+
+    qsort(vec->data, k, sizeof(int), compare_ints);
 }
 
-void vec_swap(Vector *vec, int i, int j)
+int vec_nth_smallest(const Vector *vec, int n)
 {
-    if (i < 0 || i >= vec->size || j < 0 || j >= vec->size)
+    if (n < 0 || n >= vec->size)
     {
-        fprintf(stderr, "Index out of bounds in vec_swap (i=%d, j=%d, size=%d)\n", i, j, vec->size);
+        fprintf(stderr, "Index out of bounds in vec_nth_smallest (n=%d, size=%d)\n", n, vec->size);
         exit(EXIT_FAILURE);
     }
 
-    int temp = vec->data[i];
-    vec->data[i] = vec->data[j];
-    vec->data[j] = temp;
+    int *scratch = copy_elements(vec);
+    select_range(scratch, 0, vec->size - 1, n);
+
+    int result = scratch[n];
+    free(scratch);
+
+    return result;
 }
 
-bool vec_equals(const Vector *v1, const Vector *v2)
+double vec_median(const Vector *vec)
 {
-    if (v1->size != v2->size)
-        return false;
+    if (vec->size == 0)
+        return 0;
+
+    int *scratch = copy_elements(vec);
+    int upper = vec->size / 2;
+
+    select_range(scratch, 0, vec->size - 1, upper);
+
+    double median = scratch[upper];
 
-    for (int i = 0; i < v1->size; i++)
+    if (vec->size % 2 == 0)
     {
-        if (v1->data[i] != v2->data[i])
-            return false;
+        // The lower middle is the largest value left of the upper middle
+        int lower = scratch[0];
+        for (int i = 1; i < upper; i++)
+        {
+            if (scratch[i] > lower)
+                lower = scratch[i];
+        }
+        median = ((double)lower + scratch[upper]) / 2;
     }
 
-    return true;
+    free(scratch);
+    return median;
+}
+
+Vector vec_quantiles(const Vector *vec, const double *quantiles, int count)
+{
+    if (count < 0)
+    {
+        fprintf(stderr, "%d is negative\n", count);
+        exit(EXIT_FAILURE);
+    }
+
+    if (count > 0 && vec->size == 0)
+    {
+        fprintf(stderr, "Cannot compute quantiles of an empty vector\n");
+        exit(EXIT_FAILURE);
+    }
+
+    Vector result = vec_create_with_capacity(count > 0 ? count : 1);
+    if (count == 0)
+        return result;
+
+    int *ranks = (int *)malloc(count * sizeof(int));
+    int *sorted_ranks = (int *)malloc(count * sizeof(int));
+    if (!ranks || !sorted_ranks)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (!(quantiles[i] >= 0.0 && quantiles[i] <= 1.0))
+        {
+            fprintf(stderr, "Quantile %f is out of range [0..1]\n", quantiles[i]);
+            exit(EXIT_FAILURE);
+        }
+        ranks[i] = (int)(quantiles[i] * (vec->size - 1) + 0.5);
+        sorted_ranks[i] = ranks[i];
+    }
+
+    // Select all distinct ranks in one pass over shrinking partitions
+    qsort(sorted_ranks, count, sizeof(int), compare_ints);
+    int distinct = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (distinct == 0 || sorted_ranks[distinct - 1] != sorted_ranks[i])
+            sorted_ranks[distinct++] = sorted_ranks[i];
+    }
+
+    int *scratch = copy_elements(vec);
+    multi_select(scratch, 0, vec->size - 1, sorted_ranks, 0, distinct - 1);
+
+    for (int i = 0; i < count; i++)
+    {
+        result.data[i] = scratch[ranks[i]];
+    }
+    result.size = count;
+
+    free(scratch);
+    free(sorted_ranks);
+    free(ranks);
+
+    return result;
+}
+
+// Keeps the k best values seen so far in a bounded heap whose root is the
+// worst of them, then heap-sorts the survivors. O(n log k) time, O(k) space.
+static Vector select_k(const Vector *vec, int k, bool largest)
+{
+    if (k < 0)
+    {
+        fprintf(stderr, "%d is negative\n", k);
+        exit(EXIT_FAILURE);
+    }
+
+    if (k > vec->size)
+        k = vec->size;
+
+    Vector result = vec_create_with_capacity(k > 0 ? k : 1);
+    if (k == 0)
+        return result;
+
+    int *heap = result.data;
+    bool max_heap = !largest;
+
+    memcpy(heap, vec->data, k * sizeof(int));
+    heap_build(heap, k, max_heap);
+
+    for (int i = k; i < vec->size; i++)
+    {
+        int value = vec->data[i];
+        if (largest ? value > heap[0] : value < heap[0])
+        {
+            heap[0] = value;
+            heap_sift_down(heap, k, 0, max_heap);
+        }
+    }
+
+    // Repeatedly moving the root to the end leaves the best value first
+    for (int end = k - 1; end > 0; end--)
+    {
+        swap_ints(&heap[0], &heap[end]);
+        heap_sift_down(heap, end, 0, max_heap);
+    }
+
+    result.size = k;
+    return result;
+}
+
+Vector vec_top_k(const Vector *vec, int k)
+{
+    return select_k(vec, k, true);
+}
+
+Vector vec_bottom_k(const Vector *vec, int k)
+{
+    return select_k(vec, k, false);
+}
+
+// -----------------------------------------------------------------------------
+// DISTINCT & FREQUENCY (Dedup, Value Counts, Histogram)
+// -----------------------------------------------------------------------------
+
+// Value ranges up to this many slots per element (plus a fixed allowance)
+// are handled with a direct counting array instead of radix sorting.
+#define COUNTING_RANGE_PER_ELEMENT 2
+#define COUNTING_RANGE_ALLOWANCE 4096
+
+typedef struct
+{
+    int min;
+    int max;
+    long long range; // max - min + 1
+} ValueRange;
+
+static ValueRange value_range(const Vector *vec)
+{
+    ValueRange r = {vec->data[0], vec->data[0], 0};
+
+    for (int i = 1; i < vec->size; i++)
+    {
+        if (vec->data[i] < r.min)
+            r.min = vec->data[i];
+        else if (vec->data[i] > r.max)
+            r.max = vec->data[i];
+    }
+
+    r.range = (long long)r.max - r.min + 1;
+    return r;
+}
+
+static bool use_counting(const Vector *vec, ValueRange r)
+{
+    return r.range <= (long long)vec->size * COUNTING_RANGE_PER_ELEMENT + COUNTING_RANGE_ALLOWANCE;
+}
+
+static void *calloc_or_exit(size_t count, size_t size)
+{
+    void *memory = calloc(count, size);
+    if (!memory)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    return memory;
+}
+
+// Packs each element as (biased value << 32 | original index) and LSD radix
+// sorts on the value half, one byte per pass. The sort is stable, so equal
+// values stay in index order. Passes where every element shares the same
+// byte are skipped.
+static uint64_t *radix_sort_with_indices(const Vector *vec)
+{
+    int n = vec->size;
+    uint64_t *items = (uint64_t *)malloc(n * sizeof(uint64_t));
+    uint64_t *scratch = (uint64_t *)malloc(n * sizeof(uint64_t));
+    if (!items || !scratch)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        uint32_t biased = (uint32_t)vec->data[i] ^ 0x80000000u;
+        items[i] = ((uint64_t)biased << 32) | (uint32_t)i;
+    }
+
+    for (int shift = 32; shift < 64; shift += 8)
+    {
+        int counts[256] = {0};
+
+        for (int i = 0; i < n; i++)
+        {
+            counts[(items[i] >> shift) & 0xFF]++;
+        }
+
+        if (counts[(items[0] >> shift) & 0xFF] == n)
+            continue;
+
+        int offset = 0;
+        for (int d = 0; d < 256; d++)
+        {
+            int count = counts[d];
+            counts[d] = offset;
+            offset += count;
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            scratch[counts[(items[i] >> shift) & 0xFF]++] = items[i];
+        }
+
+        uint64_t *temp = items;
+        items = scratch;
+        scratch = temp;
+    }
+
+    free(scratch);
+    return items;
+}
+
+static int radix_value(uint64_t item)
+{
+    return (int)((uint32_t)(item >> 32) ^ 0x80000000u);
+}
+
+static int radix_index(uint64_t item)
+{
+    return (int)(uint32_t)item;
+}
+
+Vector vec_distinct(const Vector *vec)
+{
+    if (vec->size == 0)
+        return vec_create();
+
+    Vector result = vec_create_with_capacity(vec->size);
+    ValueRange r = value_range(vec);
+
+    if (use_counting(vec, r))
+    {
+        bool *seen = (bool *)calloc_or_exit(r.range, sizeof(bool));
+
+        for (int i = 0; i < vec->size; i++)
+        {
+            int slot = vec->data[i] - r.min;
+            if (!seen[slot])
+            {
+                seen[slot] = true;
+                result.data[result.size++] = vec->data[i];
+            }
+        }
+
+        free(seen);
+    }
+    else
+    {
+        // The stable sort leaves the first occurrence at the head of each run
+        uint64_t *items = radix_sort_with_indices(vec);
+        bool *keep = (bool *)calloc_or_exit(vec->size, sizeof(bool));
+
+        for (int i = 0; i < vec->size; i++)
+        {
+            if (i == 0 || radix_value(items[i]) != radix_value(items[i - 1]))
+                keep[radix_index(items[i])] = true;
+        }
+
+        for (int i = 0; i < vec->size; i++)
+        {
+            if (keep[i])
+                result.data[result.size++] = vec->data[i];
+        }
+
+        free(keep);
+        free(items);
+    }
+
+    return result;
+}
+
+Vector vec_distinct_sorted(const Vector *vec)
+{
+    Vector values;
+    Vector counts;
+
+    vec_value_counts(vec, &values, &counts);
+    vec_destroy(&counts);
+
+    return values;
+}
+
+void vec_dedup_sorted(Vector *vec)
+{
+    vec_invalidate(vec);
+    if (vec->size == 0)
+        return;
+
+    int write = 1;
+
+    for (int read = 1; read < vec->size; read++)
+    {
+        if (vec->data[read] != vec->data[write - 1])
+            vec->data[write++] = vec->data[read];
+    }
+
+    vec->size = write;
+}
+
+Vector vec_histogram(const Vector *vec, int min_value, int max_value)
+{
+    if (min_value > max_value)
+    {
+        fprintf(stderr, "Error: Invalid range: min (%d) is greater than max (%d).\n", min_value, max_value);
+        exit(EXIT_FAILURE);
+    }
+
+    long long range = (long long)max_value - min_value + 1;
+    if (range > INT_MAX)
+    {
+        fprintf(stderr, "Histogram range is too large (%lld buckets)\n", range);
+        exit(EXIT_FAILURE);
+    }
+
+    Vector counts = vec_create_with_capacity((int)range);
+    memset(counts.data, 0, range * sizeof(int));
+    counts.size = (int)range;
+
+    for (int i = 0; i < vec->size; i++)
+    {
+        int value = vec->data[i];
+        if (value >= min_value && value <= max_value)
+            counts.data[value - min_value]++;
+    }
+
+    return counts;
+}
+
+void vec_value_counts(const Vector *vec, Vector *values, Vector *counts)
+{
+    if (vec->size == 0)
+    {
+        *values = vec_create();
+        *counts = vec_create();
+        return;
+    }
+
+    ValueRange r = value_range(vec);
+
+    if (use_counting(vec, r))
+    {
+        Vector dense = vec_histogram(vec, r.min, r.max);
+        int distinct = 0;
+
+        for (int i = 0; i < dense.size; i++)
+        {
+            distinct += dense.data[i] != 0;
+        }
+
+        *values = vec_create_with_capacity(distinct);
+        *counts = vec_create_with_capacity(distinct);
+
+        for (int i = 0; i < dense.size; i++)
+        {
+            if (dense.data[i] != 0)
+            {
+                values->data[values->size++] = r.min + i;
+                counts->data[counts->size++] = dense.data[i];
+            }
+        }
+
+        vec_destroy(&dense);
+        return;
+    }
+
+    uint64_t *items = radix_sort_with_indices(vec);
+
+    *values = vec_create_with_capacity(vec->size);
+    *counts = vec_create_with_capacity(vec->size);
+
+    for (int i = 0; i < vec->size; i++)
+    {
+        int value = radix_value(items[i]);
+
+        if (values->size > 0 && values->data[values->size - 1] == value)
+        {
+            counts->data[counts->size - 1]++;
+        }
+        else
+        {
+            values->data[values->size++] = value;
+            counts->data[counts->size++] = 1;
+        }
+    }
+
+    free(items);
+    vec_trim_to_size(values);
+    vec_trim_to_size(counts);
+}
+
+// -----------------------------------------------------------------------------
+// PREFIX SUMS (Running Totals, Range Sums)
+// -----------------------------------------------------------------------------
+
+// Elements per block in vec_prefix_sums_parallel; each block is scanned by
+// one thread, then shifted by the total of the blocks before it.
+#ifndef PREFIX_SUM_BLOCK_SIZE
+#define PREFIX_SUM_BLOCK_SIZE (1 << 16)
+#endif
+
+static long long *alloc_prefix_sums(int size)
+{
+    long long *sums = (long long *)malloc((size + 1) * sizeof(long long));
+    if (!sums)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    sums[0] = 0;
+    return sums;
+}
+
+void vec_prefix_sum(Vector *vec)
+{
+    vec_invalidate(vec);
+    int *data = vec->data;
+    int i = 0;
+
+#if defined(__SSE2__)
+    // Scan four lanes at a time: two shifted adds give the in-register scan,
+    // then the running total of the previous block is broadcast and added.
+    __m128i carry = _mm_setzero_si128();
+
+    for (; i + 4 <= vec->size; i += 4)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i *)(data + i));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi32(x, carry);
+        _mm_storeu_si128((__m128i *)(data + i), x);
+        carry = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+#endif
+
+    // Unsigned so overflow wraps exactly like the SSE2 lanes above
+    unsigned running = i > 0 ? (unsigned)data[i - 1] : 0u;
+
+    for (; i < vec->size; i++)
+    {
+        running += (unsigned)data[i];
+        data[i] = (int)running;
+    }
+}
+
+long long *vec_prefix_sums(const Vector *vec)
+{
+    long long *sums = alloc_prefix_sums(vec->size);
+    long long running = 0;
+
+    for (int i = 0; i < vec->size; i++)
+    {
+        running += vec->data[i];
+        sums[i + 1] = running;
+    }
+
+    return sums;
+}
+
+long long *vec_prefix_sums_parallel(const Vector *vec)
+{
+    int block_count = (vec->size + PREFIX_SUM_BLOCK_SIZE - 1) / PREFIX_SUM_BLOCK_SIZE;
+
+    if (block_count <= 1)
+        return vec_prefix_sums(vec);
+
+    long long *sums = alloc_prefix_sums(vec->size);
+    long long *block_offsets = (long long *)malloc(block_count * sizeof(long long));
+    if (!block_offsets)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Pass 1: independent local scan of every block
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int b = 0; b < block_count; b++)
+    {
+        int start = b * PREFIX_SUM_BLOCK_SIZE;
+        int end = start + PREFIX_SUM_BLOCK_SIZE < vec->size ? start + PREFIX_SUM_BLOCK_SIZE : vec->size;
+        long long running = 0;
+
+        for (int i = start; i < end; i++)
+        {
+            running += vec->data[i];
+            sums[i + 1] = running;
+        }
+    }
+
+    // Serial scan over the (few) block totals
+    long long offset = 0;
+    for (int b = 0; b < block_count; b++)
+    {
+        block_offsets[b] = offset;
+        int last = (b + 1) * PREFIX_SUM_BLOCK_SIZE < vec->size ? (b + 1) * PREFIX_SUM_BLOCK_SIZE : vec->size;
+        offset += sums[last];
+    }
+
+    // Pass 2: shift every block but the first by the total before it
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int b = 1; b < block_count; b++)
+    {
+        int start = b * PREFIX_SUM_BLOCK_SIZE;
+        int end = start + PREFIX_SUM_BLOCK_SIZE < vec->size ? start + PREFIX_SUM_BLOCK_SIZE : vec->size;
+
+        for (int i = start; i < end; i++)
+        {
+            sums[i + 1] += block_offsets[b];
+        }
+    }
+
+    free(block_offsets);
+    return sums;
+}
+
+long long vec_range_sum(const long long *prefix_sums, int size, int from_index, int to_index)
+{
+    if (from_index < 0 || to_index > size)
+    {
+        fprintf(stderr, "Invalid range in vec_range_sum (from=%d, to=%d, size=%d)\n", from_index, to_index, size);
+        exit(EXIT_FAILURE);
+    }
+
+    if (from_index > to_index)
+    {
+        fprintf(stderr, "Indices are out of order\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return prefix_sums[to_index] - prefix_sums[from_index];
+}
+
+// -----------------------------------------------------------------------------
+// SLIDING WINDOWS (Moving Min, Max, Sum, Mean)
+// -----------------------------------------------------------------------------
+
+static void check_window(int window)
+{
+    if (window <= 0)
+    {
+        fprintf(stderr, "Window size %d is not positive\n", window);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Number of full windows over vec (zero when the window is longer than vec)
+static int window_count(const Vector *vec, int window)
+{
+    check_window(window);
+    return vec->size >= window ? vec->size - window + 1 : 0;
+}
+
+// Monotonic deque of positions: values at the queued positions only ever
+// get worse from front to back, so the front is the window's best and every
+// position is pushed and popped at most once.
+static Vector window_extreme(const Vector *vec, int window, bool want_max)
+{
+    int count = window_count(vec, window);
+    Vector result = vec_alloc_exact(count);
+    const int *data = vec->data;
+
+    if (count == 0)
+        return result;
+
+    int *queue = (int *)malloc(vec->size * sizeof(int));
+    if (!queue)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int head = 0;
+    int tail = 0;
+
+    for (int i = 0; i < vec->size; i++)
+    {
+        if (want_max)
+        {
+            while (tail > head && data[queue[tail - 1]] <= data[i])
+                tail--;
+        }
+        else
+        {
+            while (tail > head && data[queue[tail - 1]] >= data[i])
+                tail--;
+        }
+        queue[tail++] = i;
+
+        if (queue[head] <= i - window)
+            head++;
+        if (i >= window - 1)
+            result.data[i - window + 1] = data[queue[head]];
+    }
+
+    free(queue);
+    result.size = count;
+    return result;
+}
+
+Vector vec_window_min(const Vector *vec, int window)
+{
+    return window_extreme(vec, window, false);
+}
+
+Vector vec_window_max(const Vector *vec, int window)
+{
+    return window_extreme(vec, window, true);
+}
+
+long long *vec_window_sum(const Vector *vec, int window)
+{
+    int count = window_count(vec, window);
+    long long *sums = (long long *)malloc((count > 0 ? count : 1) * sizeof(long long));
+    if (!sums)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    const int *data = vec->data;
+    long long running = 0;
+
+    for (int i = 0; i < vec->size; i++)
+    {
+        running += data[i];
+        if (i >= window)
+            running -= data[i - window];
+        if (i >= window - 1)
+            sums[i - window + 1] = running;
+    }
+
+    return sums;
+}
+
+double *vec_window_mean(const Vector *vec, int window)
+{
+    int count = window_count(vec, window);
+    double *means = (double *)malloc((count > 0 ? count : 1) * sizeof(double));
+    if (!means)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    const int *data = vec->data;
+    long long running = 0;
+
+    for (int i = 0; i < vec->size; i++)
+    {
+        running += data[i];
+        if (i >= window)
+            running -= data[i - window];
+        if (i >= window - 1)
+            means[i - window + 1] = (double)running / window;
+    }
+
+    return means;
+}
+
+VecSlidingWindow vec_sliding_create(int window)
+{
+    check_window(window);
+
+    VecSlidingWindow sliding;
+    sliding.window = window;
+    sliding.values = (int *)malloc(window * sizeof(int));
+    sliding.min_queue = (long long *)malloc(window * sizeof(long long));
+    sliding.max_queue = (long long *)malloc(window * sizeof(long long));
+    if (!sliding.values || !sliding.min_queue || !sliding.max_queue)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    sliding.pushed = 0;
+    sliding.sum = 0;
+    sliding.min_head = sliding.min_count = 0;
+    sliding.max_head = sliding.max_count = 0;
+    return sliding;
+}
+
+void vec_sliding_destroy(VecSlidingWindow *sliding)
+{
+    free(sliding->values);
+    free(sliding->min_queue);
+    free(sliding->max_queue);
+    sliding->values = NULL;
+    sliding->min_queue = sliding->max_queue = NULL;
+    sliding->pushed = 0;
+    sliding->sum = 0;
+    sliding->min_count = sliding->max_count = 0;
+}
+
+// Drops the front entry if it has left the window (its ring slot is about
+// to be reused), then adds position after dropping the back entries it makes
+// irrelevant
+static void sliding_enqueue(const VecSlidingWindow *sliding, long long *queue, int *head, int *count,
+                            long long position, bool want_max)
+{
+    int window = sliding->window;
+    int value = sliding->values[position % window];
+
+    if (*count > 0 && queue[*head] <= position - window)
+    {
+        *head = (*head + 1) % window;
+        (*count)--;
+    }
+
+    while (*count > 0)
+    {
+        int back = sliding->values[queue[(*head + *count - 1) % window] % window];
+        if (want_max ? back > value : back < value)
+            break;
+        (*count)--;
+    }
+
+    queue[(*head + *count) % window] = position;
+    (*count)++;
+}
+
+void vec_sliding_push(VecSlidingWindow *sliding, int value)
+{
+    int slot = (int)(sliding->pushed % sliding->window);
+
+    if (sliding->pushed >= sliding->window)
+        sliding->sum -= sliding->values[slot];
+    sliding->values[slot] = value;
+    sliding->sum += value;
+
+    sliding_enqueue(sliding, sliding->min_queue, &sliding->min_head, &sliding->min_count, sliding->pushed, false);
+    sliding_enqueue(sliding, sliding->max_queue, &sliding->max_head, &sliding->max_count, sliding->pushed, true);
+    sliding->pushed++;
+}
+
+void vec_sliding_push_all(VecSlidingWindow *sliding, const Vector *values)
+{
+    for (int i = 0; i < values->size; i++)
+    {
+        vec_sliding_push(sliding, values->data[i]);
+    }
+}
+
+int vec_sliding_count(const VecSlidingWindow *sliding)
+{
+    return sliding->pushed < sliding->window ? (int)sliding->pushed : sliding->window;
+}
+
+static void check_sliding_not_empty(const VecSlidingWindow *sliding)
+{
+    if (sliding->pushed == 0)
+    {
+        fprintf(stderr, "Sliding window is empty\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+int vec_sliding_min(const VecSlidingWindow *sliding)
+{
+    check_sliding_not_empty(sliding);
+    return sliding->values[sliding->min_queue[sliding->min_head] % sliding->window];
+}
+
+int vec_sliding_max(const VecSlidingWindow *sliding)
+{
+    check_sliding_not_empty(sliding);
+    return sliding->values[sliding->max_queue[sliding->max_head] % sliding->window];
+}
+
+long long vec_sliding_sum(const VecSlidingWindow *sliding)
+{
+    return sliding->sum;
+}
+
+double vec_sliding_mean(const VecSlidingWindow *sliding)
+{
+    check_sliding_not_empty(sliding);
+    return (double)sliding->sum / vec_sliding_count(sliding);
+}
+
+// -----------------------------------------------------------------------------
+// PREDICATE-BASED LOGIC (Checks all/any/none elements)
+// -----------------------------------------------------------------------------
+
+bool vec_none(const Vector *vec, Predicate predicate)
+{
+    for (int i = 0; i < vec->size; i++)
+    {
+        if (predicate(vec->data[i]))
+            return false;
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// UTILITY & DEBUGGING (Miscellaneous Helpers)
+// -----------------------------------------------------------------------------
+
+char *vec_to_string(const Vector *vec)
+{
+    if (vec == NULL || vec->size == 0)
+    {
+        char *empty = malloc(3);
+        if (empty)
+            strcpy(empty, "[]");
+        return empty;
+    }
+
+    int est_len = vec->size * 14 + 3; // generous estimate
+    char *buffer = malloc(est_len);
+    if (!buffer)
+        return NULL;
+
+    int offset = 0;
+    offset += snprintf(buffer + offset, est_len - offset, "[");
+
+    for (int i = 0; i < vec->size; ++i)
+    {
+        offset += snprintf(buffer + offset, est_len - offset, "%d", vec->data[i]);
+        if (i < vec->size - 1)
+            offset += snprintf(buffer + offset, est_len - offset, ", ");
+    }
+
+    snprintf(buffer + offset, est_len - offset, "]");
+    return buffer;
+}
+
+void vec_printf(const Vector *vec)
+{
+    char *str = vec_to_string(vec);
+    if (str)
+    {
+        puts(str);
+        free(str);
+    }
+}
+
+void vec_swap(Vector *vec, int i, int j)
+{
+    vec_invalidate(vec);
+    if (i < 0 || i >= vec->size || j < 0 || j >= vec->size)
+    {
+        fprintf(stderr, "Index out of bounds in vec_swap (i=%d, j=%d, size=%d)\n", i, j, vec->size);
+        exit(EXIT_FAILURE);
+    }
+
+    int temp = vec->data[i];
+    vec->data[i] = vec->data[j];
+    vec->data[j] = temp;
+}
+
+bool vec_equals(const Vector *v1, const Vector *v2)
+{
+    if (v1->size != v2->size)
+        return false;
+
+    // Cached fingerprints of different contents reject without a scan
+    if (v1->fingerprint != 0 && v2->fingerprint != 0 && v1->fingerprint != v2->fingerprint)
+        return false;
+
+    if (v1->size == 0 || v1->data == v2->data)
+        return true;
+
+    return memcmp(v1->data, v2->data, v1->size * sizeof(int)) == 0;
+}
+
+
+// -----------------------------------------------------------------------------
+// HASHING & FINGERPRINTS (Seeded 64-bit Hash, Cached Fingerprint)
+// -----------------------------------------------------------------------------
+
+// Ints per block; every lane accumulator is scrambled once per block
+#define VEC_HASH_STRIPE 8
+#define VEC_HASH_BLOCK (16 * VEC_HASH_STRIPE)
+
+#define VEC_HASH_PRIME32 0x9E3779B1u
+#define VEC_HASH_PRIME64_1 0x9E3779B185EBCA87ull
+#define VEC_HASH_PRIME64_2 0xC2B2AE3D27D4EB4Full
+
+static const uint64_t vec_hash_keys[4] = {
+    0xBE4BA423396CFEB8ull, 0x1CAD21F72C81017Cull, 0xDB979083E96DD4DEull, 0x1F67B3B7A4A44072ull};
+
+static uint64_t hash_rotl(uint64_t x, int bits)
+{
+    return (x << bits) | (x >> (64 - bits));
+}
+
+// Final avalanche (MurmurHash3 fmix64)
+static uint64_t hash_mix(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+// Four independent 64-bit lanes, each fed one pair of ints per stripe: the
+// pair is added to the neighbouring lane and the product of its key-mixed
+// halves to its own, so there is no dependency chain across lanes. SSE2
+// handles two lanes per register and gives the same result as the scalar
+// path.
+static void hash_stripes(uint64_t *acc, const uint64_t *keys, const int *data, int stripes, bool scramble)
+{
+#if defined(__SSE2__)
+    __m128i acc01 = _mm_loadu_si128((const __m128i *)acc);
+    __m128i acc23 = _mm_loadu_si128((const __m128i *)(acc + 2));
+    __m128i key01 = _mm_loadu_si128((const __m128i *)keys);
+    __m128i key23 = _mm_loadu_si128((const __m128i *)(keys + 2));
+
+    for (int s = 0; s < stripes; s++)
+    {
+        const int *stripe = data + s * VEC_HASH_STRIPE;
+        __m128i v01 = _mm_loadu_si128((const __m128i *)stripe);
+        __m128i v23 = _mm_loadu_si128((const __m128i *)(stripe + 4));
+        __m128i k01 = _mm_xor_si128(v01, key01);
+        __m128i k23 = _mm_xor_si128(v23, key23);
+
+        acc01 = _mm_add_epi64(acc01, _mm_shuffle_epi32(v01, _MM_SHUFFLE(1, 0, 3, 2)));
+        acc23 = _mm_add_epi64(acc23, _mm_shuffle_epi32(v23, _MM_SHUFFLE(1, 0, 3, 2)));
+        acc01 = _mm_add_epi64(acc01, _mm_mul_epu32(k01, _mm_srli_epi64(k01, 32)));
+        acc23 = _mm_add_epi64(acc23, _mm_mul_epu32(k23, _mm_srli_epi64(k23, 32)));
+    }
+
+    if (scramble)
+    {
+        __m128i prime = _mm_set1_epi32((int)VEC_HASH_PRIME32);
+        __m128i *lanes[2] = {&acc01, &acc23};
+        __m128i keys_of[2] = {key01, key23};
+
+        for (int r = 0; r < 2; r++)
+        {
+            __m128i x = *lanes[r];
+            x = _mm_xor_si128(x, _mm_srli_epi64(x, 47));
+            x = _mm_xor_si128(x, keys_of[r]);
+            // 64 x 32-bit multiply from two 32 x 32 -> 64-bit products
+            __m128i lo = _mm_mul_epu32(x, prime);
+            __m128i hi = _mm_mul_epu32(_mm_srli_epi64(x, 32), prime);
+            *lanes[r] = _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));
+        }
+    }
+
+    _mm_storeu_si128((__m128i *)acc, acc01);
+    _mm_storeu_si128((__m128i *)(acc + 2), acc23);
+#else
+    for (int s = 0; s < stripes; s++)
+    {
+        const int *stripe = data + s * VEC_HASH_STRIPE;
+
+        for (int lane = 0; lane < 4; lane++)
+        {
+            uint64_t v = (uint64_t)(uint32_t)stripe[2 * lane] | (uint64_t)(uint32_t)stripe[2 * lane + 1] << 32;
+            uint64_t k = v ^ keys[lane];
+
+            acc[lane ^ 1] += v;
+            acc[lane] += (k & 0xFFFFFFFFu) * (k >> 32);
+        }
+    }
+
+    if (scramble)
+    {
+        for (int lane = 0; lane < 4; lane++)
+        {
+            uint64_t x = acc[lane];
+            x ^= x >> 47;
+            x ^= keys[lane];
+            acc[lane] = x * VEC_HASH_PRIME32;
+        }
+    }
+#endif
+}
+
+uint64_t vec_hash(const Vector *vec, uint64_t seed)
+{
+    const int *data = vec->data;
+    int size = vec->size;
+    uint64_t keys[4];
+    uint64_t acc[4];
+
+    for (int lane = 0; lane < 4; lane++)
+    {
+        keys[lane] = vec_hash_keys[lane] + (lane & 1 ? 0 - seed : seed);
+        acc[lane] = keys[lane] ^ VEC_HASH_PRIME64_2;
+    }
+
+    int i = 0;
+    for (; i + VEC_HASH_BLOCK <= size; i += VEC_HASH_BLOCK)
+    {
+        hash_stripes(acc, keys, data + i, VEC_HASH_BLOCK / VEC_HASH_STRIPE, true);
+    }
+
+    int stripes = (size - i) / VEC_HASH_STRIPE;
+    hash_stripes(acc, keys, data + i, stripes, false);
+    i += stripes * VEC_HASH_STRIPE;
+
+    // Up to seven leftover ints, dealt round-robin to the lanes
+    for (int k = 0; i < size; i++, k++)
+    {
+        int lane = k & 3;
+        acc[lane] = hash_rotl(acc[lane] ^ (uint32_t)data[i] * VEC_HASH_PRIME64_1, 31) * VEC_HASH_PRIME64_2;
+    }
+
+    // The length goes in last, so vectors that share a prefix still differ
+    uint64_t h = (uint64_t)size * VEC_HASH_PRIME64_1 ^ seed;
+    for (int lane = 0; lane < 4; lane++)
+    {
+        h = hash_rotl(h ^ hash_mix(acc[lane]), 27) * VEC_HASH_PRIME64_1 + VEC_HASH_PRIME64_2;
+    }
+
+    return hash_mix(h);
+}
+
+uint64_t vec_fingerprint(Vector *vec)
+{
+    if (vec->fingerprint == 0)
+    {
+        uint64_t hash = vec_hash(vec, 0);
+        vec->fingerprint = hash != 0 ? hash : 1; // 0 means "not cached"
+    }
+
+    return vec->fingerprint;
+}
+
+// -----------------------------------------------------------------------------
+// INCREMENTAL EXECUTION (Resumable Jobs With a Work Budget)
+// -----------------------------------------------------------------------------
+
+// Work done between two checks of the clock in vec_job_step
+#ifndef VEC_JOB_CHUNK
+#define VEC_JOB_CHUNK 1024
+#endif
+
+enum
+{
+    MERGE_PHASE_CHECK_FIRST,
+    MERGE_PHASE_CHECK_SECOND,
+    MERGE_PHASE_MERGE
+};
+
+enum
+{
+    UNION_PHASE_COPY,
+    UNION_PHASE_ADD_NEW
+};
+
+static double job_clock_seconds(void)
+{
+#if defined(CLOCK_MONOTONIC)
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static VecJob job_init(VecJobKind kind, const Vector *src1, const Vector *src2, int result_capacity)
+{
+    VecJob job;
+    job.kind = kind;
+    job.src1 = src1;
+    job.src2 = src2;
+    job.mapper = NULL;
+    job.phase = 0;
+    job.i = 0;
+    job.j = 0;
+    job.done = false;
+    job.result = vec_create_with_capacity(result_capacity > 0 ? result_capacity : DEFAULT_CAPACITY);
+    job.text = NULL;
+    job.text_length = 0;
+    job.text_capacity = 0;
+    return job;
+}
+
+VecJob vec_job_map(const Vector *vec, Function mapper)
+{
+    VecJob job = job_init(VEC_JOB_MAP, vec, NULL, vec->size);
+    job.mapper = mapper;
+    return job;
+}
+
+VecJob vec_job_merge(const Vector *vec1, const Vector *vec2)
+{
+    return job_init(VEC_JOB_MERGE, vec1, vec2, vec1->size + vec2->size);
+}
+
+VecJob vec_job_union(const Vector *vec1, const Vector *vec2)
+{
+    return job_init(VEC_JOB_UNION, vec1, vec2, vec1->size + vec2->size);
+}
+
+VecJob vec_job_to_string(const Vector *vec)
+{
+    VecJob job = job_init(VEC_JOB_TO_STRING, vec, NULL, 1);
+
+    job.text_capacity = vec->size * 14 + 3; // same estimate as vec_to_string
+    job.text = (char *)malloc(job.text_capacity);
+    if (!job.text)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    job.text_length = snprintf(job.text, job.text_capacity, "[");
+    return job;
+}
+
+// Each runner does roughly max_work units (at least one) and returns how
+// many it did, setting job->done once the operation is complete.
+
+static long long job_run_map(VecJob *job, long long max_work)
+{
+    int end = job->i + max_work < job->src1->size ? job->i + (int)max_work : job->src1->size;
+    int start = job->i;
+
+    for (; job->i < end; job->i++)
+    {
+        job->result.data[job->i] = job->mapper(job->src1->data[job->i]);
+    }
+
+    job->result.size = end;
+    job->done = end == job->src1->size;
+    return end - start;
+}
+
+static long long job_run_merge(VecJob *job, long long max_work)
+{
+    const Vector *a = job->src1;
+    const Vector *b = job->src2;
+    long long work = 0;
+
+    if (job->phase != MERGE_PHASE_MERGE)
+    {
+        // Validate sortedness incrementally, one input after the other
+        const Vector *checked = job->phase == MERGE_PHASE_CHECK_FIRST ? a : b;
+        int *cursor = job->phase == MERGE_PHASE_CHECK_FIRST ? &job->i : &job->j;
+
+        for (; *cursor + 1 < checked->size && work < max_work; (*cursor)++, work++)
+        {
+            if (checked->data[*cursor] > checked->data[*cursor + 1])
+            {
+                fprintf(stderr, "The vectors are not sorted\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        if (*cursor + 1 >= checked->size)
+        {
+            *cursor = 0;
+            job->phase++;
+        }
+        return work > 0 ? work : 1;
+    }
+
+    int *out = job->result.data;
+    int k = job->result.size;
+
+    while (job->i < a->size && job->j < b->size && work < max_work)
+    {
+        out[k++] = b->data[job->j] < a->data[job->i] ? b->data[job->j++] : a->data[job->i++];
+        work++;
+    }
+    while (job->i < a->size && work < max_work)
+    {
+        out[k++] = a->data[job->i++];
+        work++;
+    }
+    while (job->j < b->size && work < max_work)
+    {
+        out[k++] = b->data[job->j++];
+        work++;
+    }
+
+    job->result.size = k;
+    job->done = job->i == a->size && job->j == b->size;
+    return work > 0 ? work : 1;
+}
+
+static long long job_run_union(VecJob *job, long long max_work)
+{
+    long long work = 0;
+
+    if (job->phase == UNION_PHASE_COPY)
+    {
+        int count = job->src1->size - job->i;
+        if (count > max_work)
+            count = (int)max_work;
+
+        memcpy(job->result.data + job->i, job->src1->data + job->i, count * sizeof(int));
+        job->i += count;
+        job->result.size = job->i;
+
+        if (job->i == job->src1->size)
+            job->phase = UNION_PHASE_ADD_NEW;
+        return count > 0 ? count : 1;
+    }
+
+    // Same semantics as vec_union: each element of src2 is checked against
+    // everything kept so far, so the cost of one element is the result size.
+    while (job->j < job->src2->size && work < max_work)
+    {
+        int element = job->src2->data[job->j++];
+
+        if (!vec_contains(&job->result, element))
+            job->result.data[job->result.size++] = element;
+
+        work += job->result.size + 1;
+    }
+
+    job->done = job->j == job->src2->size;
+    return work > 0 ? work : 1;
+}
+
+static long long job_run_to_string(VecJob *job, long long max_work)
+{
+    const Vector *vec = job->src1;
+    int end = job->i + max_work < vec->size ? job->i + (int)max_work : vec->size;
+    int start = job->i;
+
+    for (; job->i < end; job->i++)
+    {
+        job->text_length += snprintf(job->text + job->text_length, job->text_capacity - job->text_length,
+                                     job->i < vec->size - 1 ? "%d, " : "%d", vec->data[job->i]);
+    }
+
+    if (job->i == vec->size)
+    {
+        snprintf(job->text + job->text_length, job->text_capacity - job->text_length, "]");
+        job->text_length++;
+        job->done = true;
+    }
+
+    return end - start > 0 ? end - start : 1;
+}
+
+VecStepStatus vec_job_step(VecJob *job, VecBudget budget)
+{
+    double deadline = budget.max_seconds > 0 ? job_clock_seconds() + budget.max_seconds : 0;
+    long long remaining = budget.max_work > 0 ? budget.max_work : LLONG_MAX;
+
+    while (!job->done && remaining > 0)
+    {
+        long long chunk = remaining < VEC_JOB_CHUNK ? remaining : VEC_JOB_CHUNK;
+        long long work;
+
+        switch (job->kind)
+        {
+        case VEC_JOB_MAP:
+            work = job_run_map(job, chunk);
+            break;
+        case VEC_JOB_MERGE:
+            work = job_run_merge(job, chunk);
+            break;
+        case VEC_JOB_UNION:
+            work = job_run_union(job, chunk);
+            break;
+        default:
+            work = job_run_to_string(job, chunk);
+            break;
+        }
+
+        remaining -= work;
+
+        if (deadline > 0 && job_clock_seconds() >= deadline)
+            break;
+    }
+
+    return job->done ? VEC_STEP_DONE : VEC_STEP_MORE;
+}
+
+Vector vec_job_take_vector(VecJob *job)
+{
+    if (!job->done || job->kind == VEC_JOB_TO_STRING)
+    {
+        fprintf(stderr, "Job has no vector result to take\n");
+        exit(EXIT_FAILURE);
+    }
+
+    Vector result = job->result;
+    job->result = vec_create();
+    return result;
+}
+
+char *vec_job_take_string(VecJob *job)
+{
+    if (!job->done || job->kind != VEC_JOB_TO_STRING)
+    {
+        fprintf(stderr, "Job has no string result to take\n");
+        exit(EXIT_FAILURE);
+    }
+
+    char *text = job->text;
+    job->text = NULL;
+    return text;
+}
+
+void vec_job_destroy(VecJob *job)
+{
+    vec_destroy(&job->result);
+    free(job->text);
+    job->text = NULL;
 }
@@ -2,7 +2,18 @@
 #define VECTOR_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "../functional/functional.h"
+#include "vector_template.h"
+
+#ifdef VEC_INLINE_ACCESS
+#include <assert.h>
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
 
 #ifndef DEFAULT_CAPACITY
 #define DEFAULT_CAPACITY 10
@@ -12,54 +23,188 @@
 #define GROW_FACTOR 2
 #endif
 
-typedef struct
+// Opt-in lookup index, see vec_enable_lookup_index
+typedef struct VecLookup VecLookup;
+
+// The int instantiation of vector_template.h. After data, size (current
+// number of elements) and capacity (elements before re-allocation) come
+//   fingerprint: cached vec_fingerprint, 0 when not cached
+//   lookup:      lookup index, NULL unless enabled
+VECTOR_STRUCT(int, Vector, uint64_t fingerprint; VecLookup *lookup;)
+
+// Strict "a < b" for vec_sort; the other callbacks come from functional.h
+typedef bool (*VectorLess)(int, int);
+
+void vec_lookup_reset(Vector *vec);
+
+// Every mutating vec_* function calls this. Code that writes through
+// vec->data directly must call it too, or stale cached state (fingerprint,
+// lookup index) makes comparisons and lookups see the old contents.
+static inline void vec_invalidate(Vector *vec)
 {
-    int *data;
-    int size;     // Current number of elements
-    int capacity; // Maximum number of elements before re-allocation
-} Vector;
+    vec->fingerprint = 0;
+    if (vec->lookup)
+        vec_lookup_reset(vec);
+}
+
+// -----------------------------------------------------------------------------
+// INLINE ACCESS (Unchecked Fast Path, Optional Inline Checked Accessors)
+// -----------------------------------------------------------------------------
+
+// No bounds checks: the caller guarantees 0 <= index < size, and for
+// vec_push_unchecked that size < capacity (e.g. after vec_ensure_capacity).
+static inline int vec_at(const Vector *vec, int index)
+{
+    return vec->data[index];
+}
+
+// Writable element pointer; drops cached state since writes may follow
+static inline int *vec_data(Vector *vec)
+{
+    vec_invalidate(vec);
+    return vec->data;
+}
+
+static inline void vec_set_unchecked(Vector *vec, int index, int element)
+{
+    vec_invalidate(vec);
+    vec->data[index] = element;
+}
+
+static inline void vec_push_unchecked(Vector *vec, int element)
+{
+    vec_invalidate(vec);
+    vec->data[vec->size++] = element;
+}
+
+// With VEC_INLINE_ACCESS defined, vec_size, vec_get, vec_set and vec_swap
+// are header-inline with assert() bounds checks instead of out-of-line calls
+// that print and exit, so they compile to plain array access under NDEBUG.
+#ifdef VEC_INLINE_ACCESS
+static inline int vec_size(const Vector *vec)
+{
+    return vec->size;
+}
+
+static inline int vec_get(const Vector *vec, int index)
+{
+    assert(index >= 0 && index < vec->size);
+    return vec->data[index];
+}
+
+static inline int vec_set(Vector *vec, int index, int element)
+{
+    assert(index >= 0 && index < vec->size);
+    int previous_element = vec->data[index];
+    vec_set_unchecked(vec, index, element);
+    return previous_element;
+}
+
+static inline void vec_swap(Vector *vec, int i, int j)
+{
+    assert(i >= 0 && i < vec->size && j >= 0 && j < vec->size);
+    int temp = vec->data[i];
+    vec_invalidate(vec);
+    vec->data[i] = vec->data[j];
+    vec->data[j] = temp;
+}
+#endif
 
 // -----------------------------------------------------------------------------
 // CORE MANAGEMENT (Creation, Destruction, Properties, Internal Resize)
 // -----------------------------------------------------------------------------
 
-Vector vec_create();
-Vector vec_create_with_capacity(int initial_capacity);
-void vec_trim_to_size(Vector *vec);
-void vec_ensure_capacity(Vector *vec, int min_capacity);
-void vec_clear(Vector *vec);
-void vec_destroy(Vector *vec);
+// Generated from the template with the functional.h callbacks: create,
+// create_with_capacity, copy, ensure_capacity, trim_to_size, clear, destroy,
+// size, is_empty, add, add_all, insert, remove, remove_last, remove_if, get,
+// set, map, replace_all, filter, foreach, all, any, find_first, find_last and
+// sort. Each one that changes the elements calls vec_invalidate, and destroy
+// frees the lookup index. A bad index makes vec_get/vec_set print and exit,
+// vec_insert/vec_remove print and return. With VEC_INLINE_ACCESS the inline
+// vec_size, vec_get and vec_set above are the ones these prototypes refer to.
+VECTOR_PROTOTYPES(int, Vector, vec, , )
+VECTOR_QUERY_PROTOTYPES(int, Vector, vec, , )
 
-int vec_size(const Vector *vec);
 int vec_capacity(const Vector *vec);
-bool vec_is_empty(const Vector *vec);
 
 // -----------------------------------------------------------------------------
-// ELEMENT MODIFICATION (Add, Insert, Remove, Set)
+// NUMA PLACEMENT & FIRST TOUCH (Page Placement for Large Vectors)
 // -----------------------------------------------------------------------------
 
-void vec_add(Vector *vec, int element);
-void vec_add_all(Vector *vec, Vector *other);
+typedef enum
+{
+    VEC_NUMA_DEFAULT,    // Pages land on the node of the thread that first touches them
+    VEC_NUMA_INTERLEAVE, // Pages are spread round-robin across all allowed nodes
+    VEC_NUMA_BIND        // Pages are placed on one node
+} VecNumaPolicy;
 
-void vec_insert(Vector *vec, int index, int element);
-void vec_insert_sorted(Vector *vec, int element);
+typedef struct
+{
+    VecNumaPolicy policy;
+    int node; // Target node for VEC_NUMA_BIND
+} VecNumaOptions;
+
+// The policy covers the initial buffer only (growth reallocates with the
+// default policy) and silently falls back to default placement where NUMA
+// policies are unavailable.
+Vector vec_create_numa(int initial_capacity, VecNumaOptions options);
 
-int vec_remove(Vector *vec, int index);
-void vec_remove_if(Vector *vec, Predicate predicate);
+// Resize to count elements and write every slot, in parallel under OpenMP
+void vec_fill(Vector *vec, int count, int value);
+void vec_iota(Vector *vec, int count, int start);
 
-int vec_set(Vector *vec, int index, int element);
+// -----------------------------------------------------------------------------
+// OWNERSHIP TRANSFER (Adopt, Release, Move, Swap)
+// -----------------------------------------------------------------------------
+
+// Takes ownership of a malloc'd buffer holding size elements (capacity slots)
+Vector vec_from_buffer_adopt(int *buffer, int size, int capacity);
+// Hands the buffer to the caller (who must free it) and leaves vec empty
+int *vec_release(Vector *vec, int *size, int *capacity);
+void vec_move(Vector *dest, Vector *src);
+void vec_swap_contents(Vector *vec1, Vector *vec2);
+
+// -----------------------------------------------------------------------------
+// DIRECT TAIL WRITES (Reserve, Commit, Read From File Descriptors)
+// -----------------------------------------------------------------------------
+
+// Returns room for n elements past the end; they count once committed
+int *vec_reserve_back(Vector *vec, int n);
+void vec_commit_back(Vector *vec, int written);
+
+// Appends raw native-endian ints read from fd until EOF or max_elements
+// (<= 0 for no limit). Returns the number appended, or -1 on error.
+int vec_read_fd(Vector *vec, int fd, int max_elements);
+
+// -----------------------------------------------------------------------------
+// ELEMENT MODIFICATION (Add, Insert, Remove, Set)
+// -----------------------------------------------------------------------------
+
+// vec_add, vec_add_all, vec_insert, vec_remove, vec_remove_if and vec_set
+// are generated (see CORE MANAGEMENT)
+void vec_insert_sorted(Vector *vec, int element);
 
 // Convenience functions for modifying ends of the vector
 void vec_add_first(Vector *vec, int element);
 void vec_add_last(Vector *vec, int element);
 int vec_remove_first(Vector *vec);
-int vec_remove_last(Vector *vec);
+
+// -----------------------------------------------------------------------------
+// ADAPTIVE LOOKUP INDEX (Bloom Filter + Position Hash, Built on Demand)
+// -----------------------------------------------------------------------------
+
+// Once enabled, the VEC_LOOKUP_THRESHOLD-th contains/indexof/last_indexof/
+// count call on an unchanged vector builds a hash of value -> first/last
+// position and count behind a Bloom filter; later calls answer in O(1) until
+// the next change. Lookups then update the index, so concurrent readers of
+// one vector need external locking. vec_destroy frees the index.
+void vec_enable_lookup_index(Vector *vec);
+void vec_disable_lookup_index(Vector *vec);
 
 // -----------------------------------------------------------------------------
 // ELEMENT ACCESS & INFORMATION (Get, Search, Indexing)
 // -----------------------------------------------------------------------------
 
-int vec_get(const Vector *vec, int index);
 int vec_get_first(const Vector *vec);
 int vec_get_last(const Vector *vec);
 
@@ -79,9 +224,7 @@ bool vec_is_sorted(const Vector *vec);
 // TRANSFORMATION & DERIVATION (New Vectors or In-Place Structure Change)
 // -----------------------------------------------------------------------------
 
-Vector vec_map(const Vector *vec, Function mapper);
-void vec_replace_all(Vector *vec, Function mapper);
-Vector vec_filter(const Vector *vec, Predicate predicate);
+// vec_map, vec_replace_all, vec_filter and vec_sort are generated
 Vector vec_subvec(const Vector *vec, int from_index, int to_index);
 Vector vec_limit(const Vector *vec, int max_size);
 Vector vec_skip(const Vector *vec, int n);
@@ -94,6 +237,10 @@ Vector vec_rotate_right(const Vector *vec, int positions);
 int *vec_to_array(const Vector *vec);
 void vec_rearrange(Vector *vec);
 Vector vec_merge(const Vector *vec1, const Vector *vec2);
+Vector vec_merge_unchecked(const Vector *vec1, const Vector *vec2);
+Vector vec_merge_parallel(const Vector *vec1, const Vector *vec2);
+Vector vec_merge_k(const Vector *vecs, int count);
+Vector vec_merge_k_unchecked(const Vector *vecs, int count);
 Vector vec_union(const Vector *vec1, const Vector *vec2);
 Vector vec_intersection(const Vector *vec1, const Vector *vec2);
 Vector vec_difference(const Vector *vec1, const Vector *vec2);
@@ -109,22 +256,102 @@ double vec_average(const Vector *vec);
 int vec_product(const Vector *vec);
 int vec_count(const Vector *vec, int element);
 
+// -----------------------------------------------------------------------------
+// SELECTION & ORDER STATISTICS (Nth Element, Median, Quantiles, Top-K)
+// -----------------------------------------------------------------------------
+
+// In-place: reorders the vector so that data[n] holds the n-th smallest value,
+// everything before it is <= and everything after it is >=.
+int vec_nth_element(Vector *vec, int n);
+void vec_partial_sort(Vector *vec, int k);
+
+// Out-of-place: the source vector is left untouched
+int vec_nth_smallest(const Vector *vec, int n);
+double vec_median(const Vector *vec);
+Vector vec_quantiles(const Vector *vec, const double *quantiles, int count);
+Vector vec_top_k(const Vector *vec, int k);
+Vector vec_bottom_k(const Vector *vec, int k);
+
+// -----------------------------------------------------------------------------
+// DISTINCT & FREQUENCY (Dedup, Value Counts, Histogram)
+// -----------------------------------------------------------------------------
+
+Vector vec_distinct(const Vector *vec);
+Vector vec_distinct_sorted(const Vector *vec);
+void vec_dedup_sorted(Vector *vec);
+Vector vec_histogram(const Vector *vec, int min_value, int max_value);
+
+// Creates *values (distinct elements, ascending) and *counts (occurrences of
+// each); the caller destroys both.
+void vec_value_counts(const Vector *vec, Vector *values, Vector *counts);
+
+// -----------------------------------------------------------------------------
+// PREFIX SUMS (Running Totals, Range Sums)
+// -----------------------------------------------------------------------------
+
+// In-place inclusive scan: data[i] becomes data[0] + ... + data[i], wrapping
+// modulo 2^32 on overflow (use vec_prefix_sums for exact 64-bit totals)
+void vec_prefix_sum(Vector *vec);
+
+// Heap-allocated 64-bit exclusive scan of size + 1 entries: sums[i] is the
+// total of the first i elements, so [from, to) sums to sums[to] - sums[from].
+long long *vec_prefix_sums(const Vector *vec);
+long long *vec_prefix_sums_parallel(const Vector *vec);
+// size is the element count of the vector the sums were built from
+long long vec_range_sum(const long long *prefix_sums, int size, int from_index, int to_index);
+
+// -----------------------------------------------------------------------------
+// SLIDING WINDOWS (Moving Min, Max, Sum, Mean)
+// -----------------------------------------------------------------------------
+
+// One result per full window: entry i covers [i, i + window), so there are
+// size - window + 1 of them (none if the window is longer than the vector).
+Vector vec_window_min(const Vector *vec, int window);
+Vector vec_window_max(const Vector *vec, int window);
+// Heap-allocated arrays of size - window + 1 entries; the caller frees them.
+// Sums are 64-bit so windows of large ints cannot overflow.
+long long *vec_window_sum(const Vector *vec, int window);
+double *vec_window_mean(const Vector *vec, int window);
+
+// Streaming window over the last `window` pushed elements. Aggregates cover
+// however many elements have been pushed until the window first fills up.
+typedef struct
+{
+    int window;           // Maximum number of elements in the window
+    int *values;          // Ring buffer of the last `window` elements
+    long long pushed;     // Elements pushed so far; the ring slot is pushed % window
+    long long sum;        // Sum of the elements in the window
+    long long *min_queue; // Ring deque of positions with increasing values
+    long long *max_queue; // Ring deque of positions with decreasing values
+    int min_head, min_count;
+    int max_head, max_count;
+} VecSlidingWindow;
+
+VecSlidingWindow vec_sliding_create(int window);
+void vec_sliding_destroy(VecSlidingWindow *sliding);
+
+void vec_sliding_push(VecSlidingWindow *sliding, int value);
+void vec_sliding_push_all(VecSlidingWindow *sliding, const Vector *values);
+
+int vec_sliding_count(const VecSlidingWindow *sliding);
+int vec_sliding_min(const VecSlidingWindow *sliding);
+int vec_sliding_max(const VecSlidingWindow *sliding);
+long long vec_sliding_sum(const VecSlidingWindow *sliding);
+double vec_sliding_mean(const VecSlidingWindow *sliding);
+
 // -----------------------------------------------------------------------------
 // PREDICATE-BASED LOGIC (Checks all/any/none elements)
 // -----------------------------------------------------------------------------
 
-bool vec_all(const Vector *vec, Predicate predicate);
-bool vec_any(const Vector *vec, Predicate predicate);
+// vec_all, vec_any, vec_find_first and vec_find_last are generated; the
+// find functions return the index of the match, or -1
 bool vec_none(const Vector *vec, Predicate predicate);
 
-int vec_find_first(const Vector *vec, Predicate predicate);
-int vec_find_last(const Vector *vec, Predicate predicate);
-
 // -----------------------------------------------------------------------------
 // HIGHER-ORDER UTILITIES (Generic application of functions)
 // -----------------------------------------------------------------------------
 
-void vec_foreach(const Vector *vec, Consumer action);
+// vec_foreach is generated (see CORE MANAGEMENT)
 
 // -----------------------------------------------------------------------------
 // UTILITY & DEBUGGING (Miscellaneous Helpers)
@@ -132,8 +359,77 @@ void vec_foreach(const Vector *vec, Consumer action);
 
 char *vec_to_string(const Vector *vec);
 void vec_printf(const Vector *vec);
+#ifndef VEC_INLINE_ACCESS
 void vec_swap(Vector *vec, int i, int j);
+#endif
 
 bool vec_equals(const Vector *vec1, const Vector *vec2);
 
+// -----------------------------------------------------------------------------
+// HASHING & FINGERPRINTS (Seeded 64-bit Hash, Cached Fingerprint)
+// -----------------------------------------------------------------------------
+
+// Depends only on the elements and the seed, not on the build (SSE2 or not)
+uint64_t vec_hash(const Vector *vec, uint64_t seed);
+// vec_hash with seed 0, cached in the vector until it is next modified
+uint64_t vec_fingerprint(Vector *vec);
+
+// -----------------------------------------------------------------------------
+// INCREMENTAL EXECUTION (Resumable Jobs With a Work Budget)
+// -----------------------------------------------------------------------------
+
+typedef enum
+{
+    VEC_STEP_MORE, // Budget used up, call vec_job_step again
+    VEC_STEP_DONE  // Result is ready to be taken
+} VecStepStatus;
+
+typedef enum
+{
+    VEC_JOB_MAP,
+    VEC_JOB_MERGE,
+    VEC_JOB_UNION,
+    VEC_JOB_TO_STRING
+} VecJobKind;
+
+// Limits for one vec_job_step call; a limit <= 0 is ignored. Work is counted
+// in element operations (for vec_job_union, one per comparison).
+typedef struct
+{
+    long long max_work;
+    double max_seconds;
+} VecBudget;
+
+// Cursor of a long-running operation. The source vectors are borrowed and
+// must not change until the job is done or destroyed.
+typedef struct
+{
+    VecJobKind kind;
+    const Vector *src1;
+    const Vector *src2;
+    Function mapper;
+    int phase; // Stage of the operation, e.g. validation before merging
+    int i;     // Cursor into src1
+    int j;     // Cursor into src2
+    bool done;
+    Vector result;
+    char *text; // VEC_JOB_TO_STRING output
+    int text_length;
+    int text_capacity;
+} VecJob;
+
+VecJob vec_job_map(const Vector *vec, Function mapper);
+VecJob vec_job_merge(const Vector *vec1, const Vector *vec2);
+VecJob vec_job_union(const Vector *vec1, const Vector *vec2);
+VecJob vec_job_to_string(const Vector *vec);
+
+VecStepStatus vec_job_step(VecJob *job, VecBudget budget);
+Vector vec_job_take_vector(VecJob *job);
+char *vec_job_take_string(VecJob *job);
+void vec_job_destroy(VecJob *job);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif // VECTOR_H
\ No newline at end of file
@@ -0,0 +1,263 @@
+#ifndef VECTOR_HPP
+#define VECTOR_HPP
+
+// Header-only C++17 wrapper over the C Vector.
+//
+// dsa::IntVector owns exactly one ::Vector and nothing else, so the C API can
+// be called on it directly through raw() with no copy. Iterators are plain
+// int pointers, which makes <algorithm> (including std::execution policies)
+// work out of the box, and map/filter/reduce take any callable so lambdas are
+// inlined instead of going through a Function/Predicate pointer.
+//
+// Memory comes from the C vector, which reports a failed allocation on stderr
+// and exits, so running out of memory ends the process rather than throwing
+// std::bad_alloc.
+
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+
+namespace dsa
+{
+
+class IntVector
+{
+public:
+    using value_type = int;
+    using size_type = int;
+    using difference_type = std::ptrdiff_t;
+    using reference = int &;
+    using const_reference = const int &;
+    using pointer = int *;
+    using const_pointer = const int *;
+    using iterator = int *;
+    using const_iterator = const int *;
+
+    // -------------------------------------------------------------------------
+    // CORE MANAGEMENT (Construction, Ownership, Properties)
+    // -------------------------------------------------------------------------
+
+    IntVector() : vec_(vec_create()) {}
+
+    IntVector(std::initializer_list<int> values) : vec_(allocate(static_cast<int>(values.size())))
+    {
+        std::memcpy(vec_.data, values.begin(), values.size() * sizeof(int));
+        vec_.size = static_cast<int>(values.size());
+    }
+
+    // Takes ownership of a C vector; the source is left empty
+    explicit IntVector(::Vector &&vec) noexcept : vec_(vec)
+    {
+        vec = ::Vector{nullptr, 0, 0, 0, nullptr};
+    }
+
+    static IntVector with_capacity(int capacity)
+    {
+        return IntVector(allocate(capacity));
+    }
+
+    IntVector(const IntVector &other) : vec_(allocate(other.vec_.size))
+    {
+        std::memcpy(vec_.data, other.vec_.data, other.vec_.size * sizeof(int));
+        vec_.size = other.vec_.size;
+    }
+
+    IntVector(IntVector &&other) noexcept : vec_(other.vec_)
+    {
+        other.vec_ = ::Vector{nullptr, 0, 0, 0, nullptr};
+    }
+
+    IntVector &operator=(IntVector other) noexcept
+    {
+        std::swap(vec_, other.vec_);
+        return *this;
+    }
+
+    ~IntVector()
+    {
+        if (vec_.data || vec_.lookup)
+            vec_destroy(&vec_);
+    }
+
+    // Gives up ownership and returns the underlying C vector
+    ::Vector release() noexcept
+    {
+        ::Vector vec = vec_;
+        vec_ = ::Vector{nullptr, 0, 0, 0, nullptr};
+        return vec;
+    }
+
+    ::Vector *raw() noexcept { return &vec_; }
+    const ::Vector *raw() const noexcept { return &vec_; }
+
+    int size() const noexcept { return vec_.size; }
+    int capacity() const noexcept { return vec_.capacity; }
+    bool empty() const noexcept { return vec_.size == 0; }
+
+    void reserve(int min_capacity) { vec_ensure_capacity(&vec_, min_capacity); }
+    void clear() noexcept { vec_clear(&vec_); }
+
+    // -------------------------------------------------------------------------
+    // ELEMENT ACCESS & MODIFICATION
+    // -------------------------------------------------------------------------
+
+    int *data() noexcept { return touch(); }
+    const int *data() const noexcept { return vec_.data; }
+
+    int &operator[](int index) noexcept { return touch()[index]; }
+    const int &operator[](int index) const noexcept { return vec_.data[index]; }
+
+    int &at(int index)
+    {
+        check_index(index);
+        return touch()[index];
+    }
+
+    const int &at(int index) const
+    {
+        check_index(index);
+        return vec_.data[index];
+    }
+
+    void push_back(int element)
+    {
+        if (vec_.size == vec_.capacity)
+            grow(vec_.size + 1);
+        touch()[vec_.size++] = element;
+    }
+
+    // -------------------------------------------------------------------------
+    // ITERATORS (Raw Pointers, Random Access)
+    // -------------------------------------------------------------------------
+
+    iterator begin() noexcept { return touch(); }
+    iterator end() noexcept { return vec_.data + vec_.size; }
+    const_iterator begin() const noexcept { return vec_.data; }
+    const_iterator end() const noexcept { return vec_.data + vec_.size; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // -------------------------------------------------------------------------
+    // HIGHER-ORDER UTILITIES (Inlinable Counterparts of vec_map & co.)
+    // -------------------------------------------------------------------------
+
+    template <class F>
+    IntVector map(F mapper) const
+    {
+        IntVector result(allocate(vec_.size));
+        const int *in = vec_.data;
+        int *out = result.vec_.data;
+
+        for (int i = 0; i < vec_.size; i++)
+            out[i] = static_cast<int>(mapper(in[i]));
+
+        result.vec_.size = vec_.size;
+        return result;
+    }
+
+    template <class F>
+    void replace_all(F mapper)
+    {
+        int *data = touch();
+
+        for (int i = 0; i < vec_.size; i++)
+            data[i] = static_cast<int>(mapper(data[i]));
+    }
+
+    template <class P>
+    IntVector filter(P predicate) const
+    {
+        IntVector result(allocate(vec_.size));
+        const int *in = vec_.data;
+        int *out = result.vec_.data;
+        int count = 0;
+
+        // Branch-free compaction: always write, only advance on a match
+        for (int i = 0; i < vec_.size; i++)
+        {
+            out[count] = in[i];
+            count += predicate(in[i]) ? 1 : 0;
+        }
+
+        result.vec_.size = count;
+        return result;
+    }
+
+    template <class T, class BinaryOp>
+    T reduce(T init, BinaryOp op) const
+    {
+        const int *in = vec_.data;
+
+        for (int i = 0; i < vec_.size; i++)
+            init = op(init, in[i]);
+
+        return init;
+    }
+
+    template <class F>
+    void for_each(F action) const
+    {
+        const int *in = vec_.data;
+
+        for (int i = 0; i < vec_.size; i++)
+            action(in[i]);
+    }
+
+    template <class P>
+    bool all(P predicate) const
+    {
+        for (int value : *this)
+            if (!predicate(value))
+                return false;
+        return true;
+    }
+
+    template <class P>
+    bool any(P predicate) const
+    {
+        for (int value : *this)
+            if (predicate(value))
+                return true;
+        return false;
+    }
+
+    bool operator==(const IntVector &other) const { return vec_equals(&vec_, &other.vec_); }
+    bool operator!=(const IntVector &other) const { return !(*this == other); }
+
+private:
+    static ::Vector allocate(int capacity)
+    {
+        ::Vector vec{nullptr, 0, 0, 0, nullptr};
+        vec_ensure_capacity(&vec, capacity > 0 ? capacity : DEFAULT_CAPACITY);
+        return vec;
+    }
+
+    void grow(int min_capacity) { vec_ensure_capacity(&vec_, min_capacity); }
+
+    // Mutable access may change the elements, so drop the cached fingerprint
+    int *touch() noexcept
+    {
+        vec_invalidate(&vec_);
+        return vec_.data;
+    }
+
+    void check_index(int index) const
+    {
+        if (index < 0 || index >= vec_.size)
+            throw std::out_of_range("dsa::IntVector index out of range");
+    }
+
+    ::Vector vec_;
+};
+
+static_assert(std::is_standard_layout<IntVector>::value, "IntVector must stay layout-compatible with Vector");
+static_assert(sizeof(IntVector) == sizeof(::Vector), "IntVector must hold nothing but a Vector");
+
+} // namespace dsa
+
+#endif // VECTOR_HPP
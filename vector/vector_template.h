@@ -0,0 +1,468 @@
+#ifndef VECTOR_TEMPLATE_H
+#define VECTOR_TEMPLATE_H
+
+// Macro templates for type-specialised vectors.
+//
+// Each instantiation gets its own struct, callback types and functions, all
+// written against T directly: elements move by plain assignment and
+// callbacks take and return T by value, so there is no void* and no
+// per-element memcpy. The int Vector in vector.h is itself an instantiation,
+// so layout ({data, size, capacity}), growth policy (DEFAULT_CAPACITY,
+// GROW_FACTOR) and error handling are shared: a bad index prints an error,
+// then get and set exit while insert and remove return (remove returns a
+// zero T).
+//
+//   DECLARE_VECTOR(T, Name, prefix)   struct, callbacks and prototypes (header)
+//   IMPLEMENT_VECTOR(T, Name, prefix) function definitions (one .c file)
+//   DEFINE_VECTOR(T, Name, prefix)    both, as static inline functions, for
+//                                     a vector private to one file
+//
+// Name##Predicate, Name##Function, Name##Consumer and Name##Less are the
+// callback types; Name##Less is a strict "a < b" used by prefix##_sort, so
+// struct elements need no operator. The first three come from
+// FUNCTIONAL_CALLBACKS in functional/callbacks.h.
+//
+// A vector that layers its own state on top uses the building blocks:
+//
+//   VECTOR_CALLBACKS(T, CB)                  CB##Predicate, ..., CB##Less
+//   VECTOR_STRUCT(T, Name, FIELDS)           struct with FIELDS appended
+//   VECTOR_PROTOTYPES(T, Name, prefix, CB, SCOPE)
+//   VECTOR_DEFINITIONS(T, Name, prefix, CB, SCOPE, INVALIDATE, RELEASE, COPY)
+//   VECTOR_QUERY_PROTOTYPES(T, Name, prefix, CB, SCOPE)
+//   VECTOR_QUERY_DEFINITIONS(T, Name, prefix, CB, SCOPE)
+//
+// The prototypes take the CB-named callback types, except that sort always
+// takes Name##Less. The query blocks hold all, any, find_first and find_last
+// (index of the match, or -1), so a vector with its own versions can leave
+// them out.
+//
+// Every generated function that changes the elements calls INVALIDATE(vec)
+// first, destroy calls RELEASE(vec) before freeing the data, and whole-range
+// copies go through COPY(dst, src, count). Plain vectors pass
+// VECTOR_NO_HOOK and VECTOR_MEMCPY.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../functional/callbacks.h"
+
+#ifndef DEFAULT_CAPACITY
+#define DEFAULT_CAPACITY 10
+#endif
+
+#ifndef GROW_FACTOR
+#define GROW_FACTOR 2
+#endif
+
+#define VECTOR_NO_HOOK(vec) ((void)(vec))
+#define VECTOR_MEMCPY(dst, src, count) \
+    ((count) > 0 ? (void)memcpy((dst), (src), (size_t)(count) * sizeof(*(dst))) : (void)0)
+
+#define VECTOR_CALLBACKS(T, CB)     \
+    FUNCTIONAL_CALLBACKS(T, CB)     \
+    typedef bool (*CB##Less)(T, T);
+
+#define VECTOR_STRUCT(T, Name, FIELDS) \
+    typedef struct                     \
+    {                                  \
+        T *data;                       \
+        int size;                      \
+        int capacity;                  \
+        FIELDS                         \
+    } Name;
+
+#define VECTOR_PROTOTYPES(T, Name, prefix, CB, SCOPE)                     \
+    SCOPE Name prefix##_create(void);                                     \
+    SCOPE Name prefix##_create_with_capacity(int initial_capacity);       \
+    SCOPE Name prefix##_copy(const Name *vec);                            \
+    SCOPE void prefix##_ensure_capacity(Name *vec, int min_capacity);     \
+    SCOPE void prefix##_trim_to_size(Name *vec);                          \
+    SCOPE void prefix##_clear(Name *vec);                                 \
+    SCOPE void prefix##_destroy(Name *vec);                               \
+    SCOPE int prefix##_size(const Name *vec);                             \
+    SCOPE bool prefix##_is_empty(const Name *vec);                        \
+                                                                          \
+    SCOPE void prefix##_add(Name *vec, T element);                        \
+    SCOPE void prefix##_add_all(Name *vec, const Name *other);            \
+    SCOPE void prefix##_insert(Name *vec, int index, T element);          \
+    SCOPE T prefix##_remove(Name *vec, int index);                        \
+    SCOPE T prefix##_remove_last(Name *vec);                              \
+    SCOPE void prefix##_remove_if(Name *vec, CB##Predicate predicate);    \
+    SCOPE T prefix##_get(const Name *vec, int index);                     \
+    SCOPE T prefix##_set(Name *vec, int index, T element);                \
+                                                                          \
+    SCOPE Name prefix##_map(const Name *vec, CB##Function mapper);        \
+    SCOPE void prefix##_replace_all(Name *vec, CB##Function mapper);      \
+    SCOPE Name prefix##_filter(const Name *vec, CB##Predicate predicate); \
+    SCOPE void prefix##_foreach(const Name *vec, CB##Consumer action);    \
+    SCOPE void prefix##_sort(Name *vec, Name##Less less);
+
+#define VECTOR_DEFINITIONS(T, Name, prefix, CB, SCOPE, INVALIDATE, RELEASE, COPY)                  \
+    static inline void prefix##_report_(const char *function, int index, int size)                 \
+    {                                                                                              \
+        fprintf(stderr, "Index out of bounds in %s (index=%d, size=%d)\n", function, index, size); \
+    }                                                                                              \
+                                                                                                   \
+    static inline void prefix##_fail_(const char *function, int index, int size)                   \
+    {                                                                                              \
+        prefix##_report_(function, index, size);                                                   \
+        exit(EXIT_FAILURE);                                                                        \
+    }                                                                                              \
+                                                                                                   \
+    static inline void prefix##_grow_(Name *vec, int new_capacity)                                 \
+    {                                                                                              \
+        if (new_capacity < DEFAULT_CAPACITY)                                                       \
+            new_capacity = DEFAULT_CAPACITY;                                                       \
+                                                                                                   \
+        T *new_data = (T *)realloc(vec->data, (size_t)new_capacity * sizeof(T));                   \
+        if (!new_data)                                                                             \
+        {                                                                                          \
+            fprintf(stderr, "Memory re-allocation failed during resize\n");                        \
+            exit(EXIT_FAILURE);                                                                    \
+        }                                                                                          \
+        vec->data = new_data;                                                                      \
+        vec->capacity = new_capacity;                                                              \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE Name prefix##_create(void)                                                               \
+    {                                                                                              \
+        return prefix##_create_with_capacity(DEFAULT_CAPACITY);                                    \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE Name prefix##_create_with_capacity(int initial_capacity)                                 \
+    {                                                                                              \
+        Name vec = {0};                                                                            \
+        prefix##_grow_(&vec, initial_capacity);                                                    \
+        return vec;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE Name prefix##_copy(const Name *vec)                                                      \
+    {                                                                                              \
+        Name copy = prefix##_create_with_capacity(vec->size);                                      \
+        COPY(copy.data, vec->data, vec->size);                                                     \
+        copy.size = vec->size;                                                                     \
+        return copy;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE void prefix##_ensure_capacity(Name *vec, int min_capacity)                               \
+    {                                                                                              \
+        if (vec->capacity >= min_capacity)                                                         \
+            return;                                                                                \
+                                                                                                   \
+        int new_capacity = vec->capacity > 0 ? vec->capacity : DEFAULT_CAPACITY;                   \
+        while (new_capacity < min_capacity)                                                        \
+            new_capacity *= GROW_FACTOR;                                                           \
+        prefix##_grow_(vec, new_capacity);                                                         \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE void prefix##_trim_to_size(Name *vec)                                                    \
+    {                                                                                              \
+        if (vec->size == 0 || vec->capacity == vec->size)                                          \
+            return;                                                                                \
+                                                                                                   \
+        T *new_data = (T *)realloc(vec->data, (size_t)vec->size * sizeof(T));                      \
+        if (new_data)                                                                              \
+        {                                                                                          \
+            vec->data = new_data;                                                                  \
+            vec->capacity = vec->size;                                                             \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE void prefix##_clear(Name *vec)                                                           \
+    {                                                                                              \
+        INVALIDATE(vec);                                                                           \
+        vec->size = 0;                                                                             \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE void prefix##_destroy(Name *vec)                                                         \
+    {                                                                                              \
+        INVALIDATE(vec);                                                                           \
+        RELEASE(vec);                                                                              \
+        free(vec->data);                                                                           \
+        vec->data = NULL;                                                                          \
+        vec->size = vec->capacity = 0;                                                             \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE int prefix##_size(const Name *vec)                                                       \
+    {                                                                                              \
+        return vec->size;                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE bool prefix##_is_empty(const Name *vec)                                                  \
+    {                                                                                              \
+        return vec->size == 0;                                                                     \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE void prefix##_add(Name *vec, T element)                                                  \
+    {                                                                                              \
+        INVALIDATE(vec);                                                                           \
+        if (vec->size == vec->capacity)                                                            \
+            prefix##_grow_(vec, vec->capacity * GROW_FACTOR);                                      \
+        vec->data[vec->size++] = element;                                                          \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE void prefix##_add_all(Name *vec, const Name *other)                                      \
+    {                                                                                              \
+        INVALIDATE(vec);                                                                           \
+        prefix##_ensure_capacity(vec, vec->size + other->size);                                    \
+        COPY(vec->data + vec->size, other->data, other->size);                                     \
+        vec->size += other->size;                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE void prefix##_insert(Name *vec, int index, T element)                                    \
+    {                                                                                              \
+        if (index < 0 || index > vec->size)                                                        \
+        {                                                                                          \
+            prefix##_report_(__func__, index, vec->size);                                          \
+            return;                                                                                \
+        }                                                                                          \
+        INVALIDATE(vec);                                                                           \
+        if (vec->size == vec->capacity)                                                            \
+            prefix##_grow_(vec, vec->capacity * GROW_FACTOR);                                      \
+                                                                                                   \
+        for (int i = vec->size; i > index; i--)                                                    \
+            vec->data[i] = vec->data[i - 1];                                                       \
+        vec->data[index] = element;                                                                \
+        vec->size++;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE T prefix##_remove(Name *vec, int index)                                                  \
+    {                                                                                              \
+        if (index < 0 || index >= vec->size)                                                       \
+        {                                                                                          \
+            prefix##_report_(__func__, index, vec->size);                                          \
+            T none = {0};                                                                          \
+            return none;                                                                           \
+        }                                                                                          \
+        INVALIDATE(vec);                                                                           \
+                                                                                                   \
+        T element = vec->data[index];                                                              \
+        for (int i = index; i < vec->size - 1; i++)                                                \
+            vec->data[i] = vec->data[i + 1];                                                       \
+        vec->size--;                                                                               \
+        return element;                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE T prefix##_remove_last(Name *vec)                                                        \
+    {                                                                                              \
+        return prefix##_remove(vec, vec->size - 1);                                                \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE void prefix##_remove_if(Name *vec, CB##Predicate predicate)                              \
+    {                                                                                              \
+        INVALIDATE(vec);                                                                           \
+        int write = 0;                                                                             \
+        for (int read = 0; read < vec->size; read++)                                               \
+        {                                                                                          \
+            if (!predicate(vec->data[read]))                                                       \
+                vec->data[write++] = vec->data[read];                                              \
+        }                                                                                          \
+        vec->size = write;                                                                         \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE T prefix##_get(const Name *vec, int index)                                               \
+    {                                                                                              \
+        if (index < 0 || index >= vec->size)                                                       \
+            prefix##_fail_(__func__, index, vec->size);                                            \
+        return vec->data[index];                                                                   \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE T prefix##_set(Name *vec, int index, T element)                                          \
+    {                                                                                              \
+        if (index < 0 || index >= vec->size)                                                       \
+            prefix##_fail_(__func__, index, vec->size);                                            \
+        INVALIDATE(vec);                                                                           \
+                                                                                                   \
+        T previous = vec->data[index];                                                             \
+        vec->data[index] = element;                                                                \
+        return previous;                                                                           \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE Name prefix##_map(const Name *vec, CB##Function mapper)                                  \
+    {                                                                                              \
+        Name result = prefix##_create_with_capacity(vec->size);                                    \
+        for (int i = 0; i < vec->size; i++)                                                        \
+            result.data[i] = mapper(vec->data[i]);                                                 \
+        result.size = vec->size;                                                                   \
+        return result;                                                                             \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE void prefix##_replace_all(Name *vec, CB##Function mapper)                                \
+    {                                                                                              \
+        INVALIDATE(vec);                                                                           \
+        for (int i = 0; i < vec->size; i++)                                                        \
+            vec->data[i] = mapper(vec->data[i]);                                                   \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE Name prefix##_filter(const Name *vec, CB##Predicate predicate)                           \
+    {                                                                                              \
+        Name result = prefix##_create_with_capacity(vec->size);                                    \
+        int count = 0;                                                                             \
+        for (int i = 0; i < vec->size; i++)                                                        \
+        {                                                                                          \
+            if (predicate(vec->data[i]))                                                           \
+                result.data[count++] = vec->data[i];                                               \
+        }                                                                                          \
+        result.size = count;                                                                       \
+        return result;                                                                             \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE void prefix##_foreach(const Name *vec, CB##Consumer action)                              \
+    {                                                                                              \
+        for (int i = 0; i < vec->size; i++)                                                        \
+            action(vec->data[i]);                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    static inline void prefix##_sift_down_(T *data, int i, int size, Name##Less less)              \
+    {                                                                                              \
+        T value = data[i];                                                                         \
+        for (int child = 2 * i + 1; child < size; child = 2 * i + 1)                               \
+        {                                                                                          \
+            if (child + 1 < size && less(data[child], data[child + 1]))                            \
+                child++;                                                                           \
+            if (!less(value, data[child]))                                                         \
+                break;                                                                             \
+            data[i] = data[child];                                                                 \
+            i = child;                                                                             \
+        }                                                                                          \
+        data[i] = value;                                                                           \
+    }                                                                                              \
+                                                                                                   \
+    static inline void prefix##_introsort_(T *data, int lo, int hi, int depth, Name##Less less)    \
+    {                                                                                              \
+        while (hi - lo > 16)                                                                       \
+        {                                                                                          \
+            if (depth-- == 0)                                                                      \
+            {                                                                                      \
+                int size = hi - lo + 1;                                                            \
+                for (int i = size / 2 - 1; i >= 0; i--)                                            \
+                    prefix##_sift_down_(data + lo, i, size, less);                                 \
+                for (int end = size - 1; end > 0; end--)                                           \
+                {                                                                                  \
+                    T top = data[lo];                                                              \
+                    data[lo] = data[lo + end];                                                     \
+                    data[lo + end] = top;                                                          \
+                    prefix##_sift_down_(data + lo, 0, end, less);                                  \
+                }                                                                                  \
+                return;                                                                            \
+            }                                                                                      \
+                                                                                                   \
+            int mid = lo + (hi - lo) / 2;                                                          \
+            T a = data[lo], b = data[mid], c = data[hi];                                           \
+            T pivot = less(a, b) ? (less(b, c) ? b : (less(a, c) ? c : a))                         \
+                                 : (less(a, c) ? a : (less(b, c) ? c : b));                        \
+            int i = lo, j = hi;                                                                    \
+            while (i <= j)                                                                         \
+            {                                                                                      \
+                while (less(data[i], pivot))                                                       \
+                    i++;                                                                           \
+                while (less(pivot, data[j]))                                                       \
+                    j--;                                                                           \
+                if (i <= j)                                                                        \
+                {                                                                                  \
+                    T temp = data[i];                                                              \
+                    data[i++] = data[j];                                                           \
+                    data[j--] = temp;                                                              \
+                }                                                                                  \
+            }                                                                                      \
+                                                                                                   \
+            if (j - lo < hi - i)                                                                   \
+            {                                                                                      \
+                prefix##_introsort_(data, lo, j, depth, less);                                     \
+                lo = i;                                                                            \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                prefix##_introsort_(data, i, hi, depth, less);                                     \
+                hi = j;                                                                            \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        for (int i = lo + 1; i <= hi; i++)                                                         \
+        {                                                                                          \
+            T value = data[i];                                                                     \
+            int j = i - 1;                                                                         \
+            while (j >= lo && less(value, data[j]))                                                \
+            {                                                                                      \
+                data[j + 1] = data[j];                                                             \
+                j--;                                                                               \
+            }                                                                                      \
+            data[j + 1] = value;                                                                   \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    SCOPE void prefix##_sort(Name *vec, Name##Less less)                                           \
+    {                                                                                              \
+        INVALIDATE(vec);                                                                           \
+        int depth = 0;                                                                             \
+        for (int n = vec->size; n > 1; n >>= 1)                                                    \
+            depth += 2;                                                                            \
+        prefix##_introsort_(vec->data, 0, vec->size - 1, depth, less);                             \
+    }
+
+#define VECTOR_QUERY_PROTOTYPES(T, Name, prefix, CB, SCOPE)                  \
+    SCOPE bool prefix##_all(const Name *vec, CB##Predicate predicate);       \
+    SCOPE bool prefix##_any(const Name *vec, CB##Predicate predicate);       \
+    SCOPE int prefix##_find_first(const Name *vec, CB##Predicate predicate); \
+    SCOPE int prefix##_find_last(const Name *vec, CB##Predicate predicate);
+
+#define VECTOR_QUERY_DEFINITIONS(T, Name, prefix, CB, SCOPE)                \
+    SCOPE bool prefix##_all(const Name *vec, CB##Predicate predicate)       \
+    {                                                                       \
+        for (int i = 0; i < vec->size; i++)                                 \
+        {                                                                   \
+            if (!predicate(vec->data[i]))                                   \
+                return false;                                               \
+        }                                                                   \
+        return true;                                                        \
+    }                                                                       \
+                                                                            \
+    SCOPE bool prefix##_any(const Name *vec, CB##Predicate predicate)       \
+    {                                                                       \
+        for (int i = 0; i < vec->size; i++)                                 \
+        {                                                                   \
+            if (predicate(vec->data[i]))                                    \
+                return true;                                                \
+        }                                                                   \
+        return false;                                                       \
+    }                                                                       \
+                                                                            \
+    SCOPE int prefix##_find_first(const Name *vec, CB##Predicate predicate) \
+    {                                                                       \
+        for (int i = 0; i < vec->size; i++)                                 \
+        {                                                                   \
+            if (predicate(vec->data[i]))                                    \
+                return i;                                                   \
+        }                                                                   \
+        return -1;                                                          \
+    }                                                                       \
+                                                                            \
+    SCOPE int prefix##_find_last(const Name *vec, CB##Predicate predicate)  \
+    {                                                                       \
+        for (int i = vec->size - 1; i >= 0; i--)                            \
+        {                                                                   \
+            if (predicate(vec->data[i]))                                    \
+                return i;                                                   \
+        }                                                                   \
+        return -1;                                                          \
+    }
+
+#define DECLARE_VECTOR(T, Name, prefix)              \
+    VECTOR_STRUCT(T, Name, )                         \
+    VECTOR_CALLBACKS(T, Name)                        \
+    VECTOR_PROTOTYPES(T, Name, prefix, Name, )       \
+    VECTOR_QUERY_PROTOTYPES(T, Name, prefix, Name, )
+#define IMPLEMENT_VECTOR(T, Name, prefix)                                                      \
+    VECTOR_DEFINITIONS(T, Name, prefix, Name, , VECTOR_NO_HOOK, VECTOR_NO_HOOK, VECTOR_MEMCPY) \
+    VECTOR_QUERY_DEFINITIONS(T, Name, prefix, Name, )
+#define DEFINE_VECTOR(T, Name, prefix)                                \
+    VECTOR_STRUCT(T, Name, )                                          \
+    VECTOR_CALLBACKS(T, Name)                                         \
+    VECTOR_PROTOTYPES(T, Name, prefix, Name, static inline)           \
+    VECTOR_QUERY_PROTOTYPES(T, Name, prefix, Name, static inline)     \
+    VECTOR_DEFINITIONS(T, Name, prefix, Name, static inline,          \
+                       VECTOR_NO_HOOK, VECTOR_NO_HOOK, VECTOR_MEMCPY) \
+    VECTOR_QUERY_DEFINITIONS(T, Name, prefix, Name, static inline)
+
+#endif // VECTOR_TEMPLATE_H